@@ -0,0 +1,173 @@
+#include "batch.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace
+{
+    enum SlotState : uint8_t { SlotFree, SlotQueued, SlotDone };
+
+    // one scramble in flight; the buffers keep their capacity between uses
+    struct Slot
+    {
+        std::string  text;
+        std::string  result;
+        int          length = 0;
+        BatchOutcome outcome = OutcomeSolved;
+        SlotState    state = SlotFree;
+    };
+
+    // the 3x3 in standard notation
+    class MoveLineSolver : public LineSolver
+    {
+    public:
+        explicit MoveLineSolver(std::unique_ptr<Solver> solver) : solver_(std::move(solver)) { moves_.reserve(64); }
+
+        BatchOutcome solveLine(const std::string& text, std::string& result, int& length) override
+        {
+            if (!parseMoves(text, moves_)) return OutcomeParseError;
+
+            RubiksCube cube;
+            cube.applyMoves(moves_);
+
+            vector<Move> sol = solver_->solve(cube);
+            if (sol.empty() && !cube.isSolved()) return OutcomeUnsolved;
+
+            length = int(sol.size());
+            appendMoves(result, sol);
+            return OutcomeSolved;
+        }
+
+    private:
+        std::unique_ptr<Solver> solver_;
+        vector<Move> moves_;
+    };
+
+    void solveSlot(Slot& s, LineSolver& solver)
+    {
+        s.result.clear();
+        s.length = 0;
+        s.outcome = solver.solveLine(s.text, s.result, s.length);
+        if (s.outcome != OutcomeSolved)
+        {
+            s.result.clear();
+            s.length = 0;
+            s.result += s.outcome == OutcomeParseError ? "ERROR" : "NONE";
+        }
+    }
+}
+
+BatchStats solveBatch(std::istream& in, std::ostream& out,
+                      const SolverFactory& makeSolver, const BatchOptions& options)
+{
+    return solveBatch(in, out, LineSolverFactory([&makeSolver]() -> std::unique_ptr<LineSolver> {
+        return std::make_unique<MoveLineSolver>(makeSolver());
+    }), options);
+}
+
+BatchStats solveBatch(std::istream& in, std::ostream& out,
+                      const LineSolverFactory& makeSolver, const BatchOptions& options)
+{
+    auto t0 = std::chrono::steady_clock::now();
+
+    int workers = options.workers > 0 ? options.workers : int(std::thread::hardware_concurrency());
+    if (workers < 1) workers = 1;
+    const long long window = std::max(1, options.window);
+
+    vector<Slot> ring(window);
+    for (Slot& s : ring) { s.text.reserve(128); s.result.reserve(128); }
+
+    // nextRead and nextWrite are only advanced by the calling thread
+    std::mutex lock;
+    std::condition_variable workReady, slotDone;
+    long long nextRead = 0, nextSolve = 0, nextWrite = 0;
+    bool inputDone = false;
+
+    auto workerLoop = [&]()
+    {
+        std::unique_ptr<LineSolver> solver = makeSolver();
+        while (true)
+        {
+            long long seq;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                workReady.wait(guard, [&] { return nextSolve < nextRead || inputDone; });
+                if (nextSolve >= nextRead) return;
+                seq = nextSolve++;
+            }
+
+            Slot& s = ring[seq % window];
+            solveSlot(s, *solver);
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                s.state = SlotDone;
+            }
+            slotDone.notify_one();
+        }
+    };
+
+    vector<std::thread> threads;
+    for (int i = 0; i < workers; ++i) threads.emplace_back(workerLoop);
+
+    BatchStats stats;
+    while (true)
+    {
+        if (!inputDone && nextRead - nextWrite < window)
+        {
+            Slot& s = ring[nextRead % window];
+            if (std::getline(in, s.text))
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    s.state = SlotQueued;
+                    ++nextRead;
+                }
+                workReady.notify_one();
+            }
+            else
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    inputDone = true;
+                }
+                workReady.notify_all();
+            }
+        }
+
+        if (inputDone && nextWrite == nextRead) break;
+
+        // block only when the ring is full or there is nothing left to read
+        const bool mustWait = inputDone || nextRead - nextWrite >= window;
+        long long ready = nextWrite;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (mustWait) slotDone.wait(guard, [&] { return ring[nextWrite % window].state == SlotDone; });
+            while (ready < nextRead && ring[ready % window].state == SlotDone) ++ready;
+        }
+
+        // finished slots belong to this thread until they are queued again
+        for (; nextWrite < ready; ++nextWrite)
+        {
+            Slot& s = ring[nextWrite % window];
+            out << s.result << '\n';
+
+            ++stats.lines;
+            switch (s.outcome) {
+            case OutcomeSolved:     ++stats.solved; stats.totalMoves += s.length; break;
+            case OutcomeUnsolved:   ++stats.unsolved; break;
+            case OutcomeParseError: ++stats.parseErrors; break;
+            }
+            s.state = SlotFree;
+        }
+    }
+
+    for (std::thread& t : threads) t.join();
+    out.flush();
+
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
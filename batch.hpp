@@ -0,0 +1,54 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include "solver.hpp"
+#include <functional>
+#include <iosfwd>
+#include <memory>
+
+///// BATCH SOLVING /////
+
+// Streams scrambles from one stream to solutions on another, one line each.
+// A reader fills a ring of `window` slots, workers solve slots in any order,
+// and results are written strictly in input order as the ring's head
+// completes, so memory stays bounded by the window whatever the input size.
+// Slot buffers are reused, so steady state parsing does not allocate.
+
+struct BatchOptions
+{
+    int workers = 0;      // solver threads, 0 = hardware concurrency
+    int window  = 1024;   // scrambles in flight between reader and writer
+};
+
+struct BatchStats
+{
+    long long lines       = 0;
+    long long solved      = 0; // includes already solved input
+    long long unsolved    = 0; // solver gave up, printed as NONE
+    long long parseErrors = 0; // printed as ERROR
+    long long totalMoves  = 0;
+    double    elapsedMs   = 0.0;
+};
+
+enum BatchOutcome : uint8_t { OutcomeSolved, OutcomeUnsolved, OutcomeParseError };
+
+// Turns one scramble line into one solution line. Cubes other than the 3x3
+// plug in here with their own notation; result arrives cleared and keeps
+// its capacity between lines.
+class LineSolver
+{
+public:
+    virtual ~LineSolver() = default;
+    virtual BatchOutcome solveLine(const std::string& text, std::string& result, int& length) = 0;
+};
+
+// makeSolver is called once per worker; every worker keeps its own solver
+using SolverFactory = std::function<std::unique_ptr<Solver>()>;
+using LineSolverFactory = std::function<std::unique_ptr<LineSolver>()>;
+
+BatchStats solveBatch(std::istream& in, std::ostream& out,
+                      const SolverFactory& makeSolver, const BatchOptions& options = BatchOptions());
+BatchStats solveBatch(std::istream& in, std::ostream& out,
+                      const LineSolverFactory& makeSolver, const BatchOptions& options = BatchOptions());
+
+#endif // BATCH_HPP
@@ -0,0 +1,241 @@
+#include <benchmark/benchmark.h>
+#include "nxnsolver.hpp"
+#include "pdb.hpp"
+#include "pocket.hpp"
+#include "stickermoves.hpp"
+
+// Run with --benchmark_format=json (or build the bench-json target) to get
+// results that can be diffed across commits. Configure with
+// -DRUBIK_SEARCH_STATS=ON to add a nodes/s counter to the IDA* runs.
+
+// ----- Corpus -----
+
+// fixed seed per depth so every run solves the same scrambles
+static const vector<RubiksCube>& scrambleCorpus(int depth)
+{
+    static vector<RubiksCube> corpora[32];
+    vector<RubiksCube>& corpus = corpora[depth];
+    if (!corpus.empty()) return corpus;
+
+    std::mt19937 rng(0x5EED0000u + depth);
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1);
+    for (int i = 0; i < 8; ++i)
+    {
+        RubiksCube cube;
+        int lastFace = -1;
+        for (int n = 0; n < depth; )
+        {
+            Move m = allMoves[moveDist(rng)];
+            if (m.face == lastFace) continue;
+            cube.applyMove(m.face, m.turn);
+            lastFace = m.face;
+            ++n;
+        }
+        corpus.push_back(cube);
+    }
+    return corpus;
+}
+
+static RubiksCube scrambledCube()
+{
+    return scrambleCorpus(20)[0];
+}
+
+// ----- Microbenchmarks -----
+
+static void BM_ApplyMove(benchmark::State& state)
+{
+    const Face face = Face(state.range(0));
+    const Turn turn = Turn(state.range(1));
+    RubiksCube cube = scrambledCube();
+    for (auto _ : state)
+    {
+        cube.applyMove(face, turn);
+        benchmark::DoNotOptimize(cube);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(moveToString(Move{face, turn}));
+}
+BENCHMARK(BM_ApplyMove)->ArgsProduct({ {Up, Down, Left, Right, Front, Back}, {CW, CCW, Double} });
+
+// a 20-move sequence through each kernel the CPU supports, the cube kept in
+// registers from the first move to the last
+static void BM_ApplyStickerMoves(benchmark::State& state)
+{
+    const StickerKernel kernel = StickerKernel(state.range(0));
+    if (!stickerKernelSupported(kernel)) { state.SkipWithError("kernel not supported on this CPU"); return; }
+
+    vector<Move> seq;
+    for (int i = 0; i < 20; ++i) seq.push_back(allMoves[(i * 7) % MOVE_COUNT]);
+    alignas(32) array<uint8_t, STICKER_STORAGE> stickers = kSolvedStickers;
+    for (auto _ : state)
+    {
+        applyStickerMoves(kernel, stickers.data(), seq.data(), seq.size());
+        benchmark::DoNotOptimize(stickers);
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(seq.size()));
+    state.SetLabel(stickerKernelName(kernel));
+}
+BENCHMARK(BM_ApplyStickerMoves)->DenseRange(KernelScalar, KernelCount - 1);
+
+static Side mixedSide()
+{
+    Side s;
+    for (int r = 0; r < Side::SIZE; ++r)
+        for (int c = 0; c < Side::SIZE; ++c) s.squares[r][c] = Color((r * Side::SIZE + c) % 6);
+    return s;
+}
+
+static void BM_SideRotateCW(benchmark::State& state)
+{
+    Side s = mixedSide();
+    for (auto _ : state) { s.rotateCW(); benchmark::DoNotOptimize(s); }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SideRotateCW);
+
+static void BM_SideRotateCCW(benchmark::State& state)
+{
+    Side s = mixedSide();
+    for (auto _ : state) { s.rotateCCW(); benchmark::DoNotOptimize(s); }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SideRotateCCW);
+
+static void BM_SideRotate180(benchmark::State& state)
+{
+    Side s = mixedSide();
+    for (auto _ : state) { s.rotate180(); benchmark::DoNotOptimize(s); }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SideRotate180);
+
+// one quarter turn of each layer from the face inwards; the outer 3x3 layer
+// is comparable with BM_ApplyMove
+template <int N>
+static void BM_NxNApplyLayer(benchmark::State& state)
+{
+    const int layer = int(state.range(0));
+    NxNCube<N> cube;
+    for (auto _ : state)
+    {
+        cube.applyLayer(Right, layer, CW);
+        benchmark::DoNotOptimize(cube);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_NxNApplyLayer, 3)->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(BM_NxNApplyLayer, 5)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_NxNApplyLayer, 7)->DenseRange(0, 3);
+
+template <int N>
+static void BM_ReductionSolve(benchmark::State& state)
+{
+    std::mt19937 rng(0x5EED0000u + N);
+    std::uniform_int_distribution<int> faceDist(0, Face::Count - 1), turnDist(0, 2), layerDist(0, N / 2);
+    vector<NxNCube<N>> corpus(8);
+    for (NxNCube<N>& cube : corpus)
+        for (int i = 0; i < 20 * N; ++i)
+        {
+            const uint8_t layer = uint8_t(layerDist(rng));
+            cube.applyMove(LayerMove{Face(faceDist(rng)), layer, layer, Turn(turnDist(rng))});
+        }
+    initTwoPhaseTables();
+    initReduction(N);
+
+    ReductionSolver<N> solver;
+    size_t i = 0, moves = 0;
+    for (auto _ : state)
+    {
+        vector<LayerMove> sol = solver.solve(corpus[i++ % corpus.size()]);
+        moves += sol.size();
+        benchmark::DoNotOptimize(sol);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["moves"] = double(moves) / double(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_ReductionSolve, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReductionSolve, 5)->Unit(benchmark::kMillisecond);
+
+// optimal 2x2 solves read straight off the distance table
+static void BM_PocketSolve(benchmark::State& state)
+{
+    if (!initPocketTable()) { state.SkipWithError("2x2 table unavailable"); return; }
+    std::mt19937 rng(0x5EED0002u);
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1);
+    vector<NxNCube<2>> corpus(64);
+    for (NxNCube<2>& cube : corpus)
+        for (int i = 0; i < 30; ++i) cube.applyMove(outerLayer(allMoves[moveDist(rng)]));
+
+    size_t i = 0, moves = 0;
+    for (auto _ : state)
+    {
+        vector<LayerMove> sol = solvePocket(corpus[i++ % corpus.size()]);
+        moves += sol.size();
+        benchmark::DoNotOptimize(sol);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["moves"] = double(moves) / double(state.iterations());
+}
+BENCHMARK(BM_PocketSolve);
+
+static void BM_CubieHeuristic(benchmark::State& state)
+{
+    const RubiksCube cube = state.range(0) ? scrambledCube() : RubiksCube();
+    for (auto _ : state) benchmark::DoNotOptimize(cube.cubieHeuristic());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CubieHeuristic)->ArgName("scrambled")->Arg(0)->Arg(1);
+
+static void BM_IsSolved(benchmark::State& state)
+{
+    const RubiksCube cube = state.range(0) ? scrambledCube() : RubiksCube();
+    for (auto _ : state) benchmark::DoNotOptimize(cube.isSolved());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsSolved)->ArgName("scrambled")->Arg(0)->Arg(1);
+
+// ----- Macrobenchmarks -----
+
+// one iteration solves the whole corpus for the given scramble depth
+static void BM_SolveIDAStar(benchmark::State& state)
+{
+    const int depth = int(state.range(0));
+    const HeuristicKind kind = HeuristicKind(state.range(1));
+    const vector<RubiksCube>& corpus = scrambleCorpus(depth);
+    if (kind != HeuristicCubie) initCornerPDB();
+    if (kind == HeuristicCornersEdges) initEdgePDBs();
+
+    SearchOptions options;
+    options.heuristic = kind;
+    SearchStats stats;
+    options.stats = &stats;
+
+    long long solutionMoves = 0;
+    [[maybe_unused]] long long nodes = 0, opposite = 0;
+    for (auto _ : state)
+    {
+        for (const RubiksCube& cube : corpus)
+        {
+            vector<Move> sol = cube.solveIDAStar(-1, depth, options);
+            solutionMoves += sol.size();
+            SEARCH_STAT(nodes += stats.totalNodes(); opposite += stats.prunedOpposite);
+            benchmark::DoNotOptimize(sol);
+        }
+    }
+
+    const double solves = double(state.iterations()) * corpus.size();
+    state.counters["solves/s"] = benchmark::Counter(solves, benchmark::Counter::kIsRate);
+    state.counters["avg_len"]  = double(solutionMoves) / solves;
+#if RUBIK_SEARCH_STATS
+    state.counters["nodes/s"]  = benchmark::Counter(double(nodes), benchmark::Counter::kIsRate);
+    state.counters["dup_rate"] = nodes > 0 ? double(opposite) / (double(nodes) * MOVE_COUNT) : 0.0;
+#endif
+}
+BENCHMARK(BM_SolveIDAStar)
+    ->ArgNames({ "depth", "heuristic" })
+    ->ArgsProduct({ benchmark::CreateDenseRange(5, 7, 1), {HeuristicCubie} })
+    ->ArgsProduct({ benchmark::CreateDenseRange(5, 12, 1), {HeuristicCorners} })
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,235 @@
+#include <iostream>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "batch.hpp"
+#include "nxnsolver.hpp"
+#include "pdb.hpp"
+#include "pocket.hpp"
+#include "softrender.hpp"
+#include "solutioncache.hpp"
+#include "stickermoves.hpp"
+#include "symmetry.hpp"
+
+// rubik-solve: one scramble per line on stdin, one solution per line on stdout.
+// A solved input prints an empty line, a search that gives up prints NONE and
+// a line that is not in move notation prints ERROR. Output keeps input order.
+
+// other sizes read WCA/SiGN layer notation and go through the reduction solver
+template <int N>
+class ReductionLineSolver : public LineSolver
+{
+public:
+    explicit ReductionLineSolver(double skeletonMs) : solver_(skeletonMs) {}
+
+    BatchOutcome solveLine(const std::string& text, std::string& result, int& length) override
+    {
+        if (!parseLayerMoves(text, N, moves_)) return OutcomeParseError;
+
+        NxNCube<N> cube;
+        cube.applyMoves(moves_);
+
+        vector<LayerMove> sol = solver_.solve(cube);
+        if (sol.empty() && !cube.isSolved()) return OutcomeUnsolved;
+
+        length = int(sol.size());
+        appendLayerMoves(result, sol);
+        return OutcomeSolved;
+    }
+
+private:
+    ReductionSolver<N> solver_;
+    vector<LayerMove> moves_;
+};
+
+// 2x2s are solved optimally from the distance table
+class PocketLineSolver : public LineSolver
+{
+public:
+    BatchOutcome solveLine(const std::string& text, std::string& result, int& length) override
+    {
+        if (!parseLayerMoves(text, 2, moves_)) return OutcomeParseError;
+
+        NxNCube<2> cube;
+        cube.applyMoves(moves_);
+
+        vector<LayerMove> sol = solvePocket(cube);
+        if (sol.empty() && !cube.isSolved()) return OutcomeUnsolved;
+
+        length = int(sol.size());
+        appendLayerMoves(result, sol);
+        return OutcomeSolved;
+    }
+
+private:
+    vector<LayerMove> moves_;
+};
+
+template <int N>
+static LineSolverFactory reductionFactory(double skeletonMs)
+{
+    return [=]() -> std::unique_ptr<LineSolver> { return std::make_unique<ReductionLineSolver<N>>(skeletonMs); };
+}
+
+static void usage()
+{
+    std::cerr <<
+        "usage: rubik-solve [options] < scrambles.txt\n"
+        "       rubik-solve --self-check\n"
+        "  --size N                cube size 2..7 (default 3); other sizes read layer notation\n"
+        "                          (Rw, 3Rw, 2R), 2x2s are solved optimally from a table and\n"
+        "                          larger cubes by reduction\n"
+        "  --solver ida|twophase|mitm   search engine (default twophase)\n"
+        "  --heuristic cubie|corners|edges   IDA* lower bound (default corners)\n"
+        "  --depth N               IDA* depth cap (default 20, mitm 14)\n"
+        "  --workers N             scrambles solved in parallel (default all cores)\n"
+        "  --window N              scrambles in flight, bounds memory (default 1024)\n"
+        "  --threads N             IDA* root-split workers and table build threads\n"
+        "  --tt-mb MB              IDA* transposition table, split across --threads (default off)\n"
+        "  --time-ms MS            two-phase time budget per scramble (default 100)\n"
+        "  --target N              two-phase stops at this length (default 20)\n"
+        "  --mitm-mb MB            meet-in-the-middle frontier budget (default 64)\n"
+        "  --pdb-dir DIR           where pattern databases are kept (default .)\n"
+        "  --pdb-mem MB            memory budget for the edge tables (default 64)\n"
+        "  --cache N               keep up to N optimal solutions (ida, mitm), shared across symmetric cubes\n"
+        "  --cache-file PATH       load the cache from PATH at start and save it back at exit\n";
+}
+
+// a count or size that may not be negative; "-1" would otherwise wrap
+static size_t nonNegative(const std::string& val)
+{
+    const long long n = std::stoll(val);
+    if (n < 0) throw std::out_of_range(val);
+    return size_t(n);
+}
+
+static size_t megabytes(const std::string& val)
+{
+    const size_t mb = nonNegative(val);
+    if (mb > (SIZE_MAX >> 20)) throw std::out_of_range(val);
+    return mb << 20;
+}
+
+static void printStats(const BatchStats& stats)
+{
+    std::clog << stats.lines << " scrambles in " << stats.elapsedMs << " ms: "
+              << stats.solved << " solved";
+    if (stats.solved > 0) std::clog << " (avg " << double(stats.totalMoves) / stats.solved << " moves)";
+    std::clog << ", " << stats.unsolved << " unsolved, " << stats.parseErrors << " unparsable\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::string solverName = "twophase";
+    SearchOptions options;
+    options.heuristic = HeuristicCorners;
+    int depth = -1;
+    size_t mitmBytes = size_t(64) << 20;
+    double timeMs = 100.0;
+    int target = 20;
+    BatchOptions batch;
+    size_t cacheEntries = 0;
+    std::string cacheFile;
+    int size = 3;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") { usage(); return 0; }
+        if (arg == "--self-check") {
+            bool ok = stickerMoveSelfCheck(std::cout);
+            ok = symmetrySelfCheck(std::cout) && ok;
+            ok = solutionCacheSelfCheck(std::cout) && ok;
+            ok = softRenderSelfCheck(std::cout) && ok;
+            ok = nxnSelfCheck(std::cout) && ok;
+            ok = pocketSelfCheck(std::cout) && ok;
+            return ok ? 0 : 1;
+        }
+        if (i + 1 >= argc) { usage(); return 2; }
+        std::string val = argv[++i];
+
+        // a value that is not a number, or out of range, is a usage error
+        try {
+            if (arg == "--solver") solverName = val;
+            else if (arg == "--size") size = std::stoi(val);
+            else if (arg == "--heuristic") {
+                if (val == "cubie")        options.heuristic = HeuristicCubie;
+                else if (val == "corners") options.heuristic = HeuristicCorners;
+                else if (val == "edges")   options.heuristic = HeuristicCornersEdges;
+                else { usage(); return 2; }
+            }
+            else if (arg == "--depth")   depth = std::stoi(val);
+            else if (arg == "--workers") batch.workers = std::stoi(val);
+            else if (arg == "--window")  batch.window = std::stoi(val);
+            else if (arg == "--threads") options.threads = pdbOptions().threads = std::stoi(val);
+            else if (arg == "--tt-mb")   options.transpositionBytes = megabytes(val);
+            else if (arg == "--time-ms") timeMs = std::stod(val);
+            else if (arg == "--target")  target = std::stoi(val);
+            else if (arg == "--mitm-mb") mitmBytes = megabytes(val);
+            else if (arg == "--pdb-dir") pdbOptions().directory = val;
+            else if (arg == "--pdb-mem") pdbOptions().memoryBudget = megabytes(val);
+            else if (arg == "--cache")   cacheEntries = nonNegative(val);
+            else if (arg == "--cache-file") cacheFile = val;
+            else { usage(); return 2; }
+        } catch (const std::logic_error&) { usage(); return 2; }
+    }
+
+    if (size < 2 || size > 7) { usage(); return 2; }
+    std::ios::sync_with_stdio(false);
+    if (size != 3)
+    {
+        LineSolverFactory makeLineSolver;
+        switch (size) {
+        case 2: makeLineSolver = []() -> std::unique_ptr<LineSolver> { return std::make_unique<PocketLineSolver>(); }; break;
+        case 4: makeLineSolver = reductionFactory<4>(timeMs); break;
+        case 5: makeLineSolver = reductionFactory<5>(timeMs); break;
+        case 6: makeLineSolver = reductionFactory<6>(timeMs); break;
+        default: makeLineSolver = reductionFactory<7>(timeMs); break;
+        }
+        if (size == 2) initPocketTable();
+        else { initTwoPhaseTables(); initReduction(size); }
+        BatchStats stats = solveBatch(std::cin, std::cout, makeLineSolver, batch);
+        printStats(stats);
+        return stats.parseErrors > 0 ? 1 : 0;
+    }
+
+    SolverFactory makeSolver;
+    if (solverName == "ida")
+        makeSolver = [=]() -> std::unique_ptr<Solver> { return std::make_unique<IDAStarSolver>(-1, depth > 0 ? depth : 20, options); };
+    else if (solverName == "mitm")
+        makeSolver = [=]() -> std::unique_ptr<Solver> {
+            return std::make_unique<MeetInMiddleSolver>(depth > 0 ? depth : 14, mitmBytes, options.heuristic);
+        };
+    else if (solverName == "twophase")
+        makeSolver = [=]() -> std::unique_ptr<Solver> { return std::make_unique<TwoPhaseSolver>(target, timeMs); };
+    else { usage(); return 2; }
+
+    // only IDA* and meet-in-the-middle answers are optimal, so only they are cached
+    const bool optimal = solverName == "ida" || solverName == "mitm";
+    std::unique_ptr<SolutionCache> cache;
+    if (optimal && (cacheEntries > 0 || !cacheFile.empty()))
+    {
+        cache = std::make_unique<SolutionCache>(cacheEntries > 0 ? cacheEntries : 100000);
+        if (!cacheFile.empty() && cache->load(cacheFile))
+            std::clog << "Loaded " << cache->size() << " cached solutions from " << cacheFile << "\n";
+        makeSolver = [inner = makeSolver, &cache]() -> std::unique_ptr<Solver> {
+            return std::make_unique<CachedSolver>(inner(), *cache);
+        };
+    }
+
+    // shared tables are built before the workers start racing for them
+    if (solverName == "twophase") initTwoPhaseTables();
+    if (optimal && options.heuristic != HeuristicCubie) initCornerPDB();
+    if (solverName == "mitm") initMeetInMiddle(mitmBytes);
+    if (solverName == "ida" && options.heuristic == HeuristicCornersEdges) initEdgePDBs();
+
+    BatchStats stats = solveBatch(std::cin, std::cout, makeSolver, batch);
+    printStats(stats);
+    if (cache)
+    {
+        std::clog << cache->summary() << "\n";
+        if (!cacheFile.empty() && !cache->save(cacheFile)) std::clog << "Could not write " << cacheFile << "\n";
+    }
+    return stats.parseErrors > 0 ? 1 : 0;
+}
@@ -0,0 +1,318 @@
+#include "coords.hpp"
+#include <chrono>
+#include <mutex>
+
+uint16_t twistMove[N_TWIST][MOVE_COUNT];
+uint16_t flipMove[N_FLIP][MOVE_COUNT];
+uint16_t cornerPermMove[N_CORNER_PERM][MOVE_COUNT];
+uint16_t sliceMove[N_SLICE][MOVE_COUNT];
+uint16_t edgeGroupMove[EDGE_GROUPS][N_EDGE_GROUP][MOVE_COUNT];
+uint16_t solvedEdgeGroup[EDGE_GROUPS];
+uint16_t edgeGroupSlots[EDGE_GROUPS][N_EDGE_GROUP];
+
+// per-coordinate piece counts backing CoordCube::cubieHeuristic
+static uint8_t twistedCorners[N_TWIST];
+static uint8_t flippedEdges[N_FLIP];
+static uint8_t misplacedCorners[N_CORNER_PERM];
+static uint8_t misplacedGroupEdges[EDGE_GROUPS][N_EDGE_GROUP];
+
+static double g_buildMs = 0.0;
+
+// ----- Helpers -----
+
+static int choose(int n, int k)
+{
+    if (k < 0 || k > n) return 0;
+    int r = 1;
+    for (int i = 1; i <= k; ++i) r = r * (n - k + i) / i;
+    return r;
+}
+
+// Lehmer rank of a permutation of 0..n-1
+static int permRank(const int* p, int n)
+{
+    int rank = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        int smaller = 0;
+        for (int j = i + 1; j < n; ++j) if (p[j] < p[i]) ++smaller;
+        rank = rank * (n - i) + smaller;
+    }
+    return rank;
+}
+
+static void permUnrank(int rank, int* p, int n)
+{
+    int digits[12];
+    for (int i = n - 1; i >= 0; --i) { digits[i] = rank % (n - i); rank /= (n - i); }
+
+    bool used[12] = {};
+    for (int i = 0; i < n; ++i)
+    {
+        int k = digits[i];
+        for (int v = 0; v < n; ++v)
+        {
+            if (used[v]) continue;
+            if (k-- == 0) { p[i] = v; used[v] = true; break; }
+        }
+    }
+}
+
+// ----- Coordinates -----
+
+int twistCoord(const CubieCube& c)
+{
+    int t = 0;
+    for (int i = 0; i < CubieCube::CORNERS - 1; ++i) t = 3 * t + c.cornerOri(i);
+    return t;
+}
+
+void setTwistCoord(CubieCube& c, int twist)
+{
+    int sum = 0;
+    for (int i = CubieCube::CORNERS - 2; i >= 0; --i)
+    {
+        c.setCorner(i, c.cornerPerm(i), twist % 3);
+        sum += twist % 3;
+        twist /= 3;
+    }
+    c.setCorner(7, c.cornerPerm(7), (3 - sum % 3) % 3);
+}
+
+int flipCoord(const CubieCube& c)
+{
+    int f = 0;
+    for (int i = 0; i < CubieCube::EDGES - 1; ++i) f = 2 * f + c.edgeOri(i);
+    return f;
+}
+
+void setFlipCoord(CubieCube& c, int flip)
+{
+    int sum = 0;
+    for (int i = CubieCube::EDGES - 2; i >= 0; --i)
+    {
+        c.setEdge(i, c.edgePerm(i), flip & 1);
+        sum += flip & 1;
+        flip >>= 1;
+    }
+    c.setEdge(11, c.edgePerm(11), sum & 1);
+}
+
+int cornerPermCoord(const CubieCube& c)
+{
+    int p[CubieCube::CORNERS];
+    for (int i = 0; i < CubieCube::CORNERS; ++i) p[i] = c.cornerPerm(i);
+    return permRank(p, CubieCube::CORNERS);
+}
+
+void setCornerPermCoord(CubieCube& c, int perm)
+{
+    int p[CubieCube::CORNERS];
+    permUnrank(perm, p, CubieCube::CORNERS);
+    for (int i = 0; i < CubieCube::CORNERS; ++i) c.setCorner(i, p[i], c.cornerOri(i));
+}
+
+// Edges 4g..4g+3 form group g. The coordinate is the combination of slots
+// they occupy (scanned from slot 11 down, so the UD slice solves to 0)
+// times 24, plus the order they appear in.
+int edgeGroupCoord(const CubieCube& c, int group)
+{
+    int comb = 0, x = 0;
+    int order[4];
+    for (int j = CubieCube::EDGES - 1; j >= 0; --j)
+    {
+        int e = c.edgePerm(j);
+        if ((e >> 2) != group) continue;
+        comb += choose(CubieCube::EDGES - 1 - j, x + 1);
+        order[3 - x] = e & 3;
+        ++x;
+    }
+    return comb * 24 + permRank(order, 4);
+}
+
+int sliceCoord(const CubieCube& c)
+{
+    return edgeGroupCoord(c, 2) / 24;
+}
+
+// lays one group's edges into its slots, returns the slots it used as a mask
+static int placeEdgeGroup(int ep[CubieCube::EDGES], int group, int coord)
+{
+    int comb = coord / 24;
+    int order[4];
+    permUnrank(coord % 24, order, 4);
+
+    int used = 0, x = 4;
+    for (int j = 0; j < CubieCube::EDGES && x > 0; ++j)
+    {
+        int c = choose(CubieCube::EDGES - 1 - j, x);
+        if (comb >= c)
+        {
+            ep[j] = 4 * group + order[4 - x];
+            used |= 1 << j;
+            comb -= c;
+            --x;
+        }
+    }
+    return used;
+}
+
+void setEdgeGroupCoords(CubieCube& c, const int groups[EDGE_GROUPS])
+{
+    int ep[CubieCube::EDGES];
+    for (int g = 0; g < EDGE_GROUPS; ++g) placeEdgeGroup(ep, g, groups[g]);
+    for (int i = 0; i < CubieCube::EDGES; ++i) c.setEdge(i, ep[i], c.edgeOri(i));
+}
+
+// only the slice edges' slots are set; the rest are filled with the others in order
+void setSliceCoord(CubieCube& c, int slice)
+{
+    int ep[CubieCube::EDGES];
+    int used = placeEdgeGroup(ep, 2, slice * 24);
+    int next = 0;
+    for (int i = 0; i < CubieCube::EDGES; ++i)
+        if (!(used & (1 << i))) ep[i] = next++;
+    for (int i = 0; i < CubieCube::EDGES; ++i) c.setEdge(i, ep[i], c.edgeOri(i));
+}
+
+// edge group alone, other slots filled with the remaining edges in order
+static void setSingleEdgeGroup(CubieCube& c, int group, int coord)
+{
+    int ep[CubieCube::EDGES];
+    int used = placeEdgeGroup(ep, group, coord);
+    int next = 0;
+    for (int i = 0; i < CubieCube::EDGES; ++i)
+    {
+        if (used & (1 << i)) continue;
+        if ((next >> 2) == group) next += 4;
+        ep[i] = next++;
+    }
+    for (int i = 0; i < CubieCube::EDGES; ++i) c.setEdge(i, ep[i], c.edgeOri(i));
+}
+
+// ----- Table Generation -----
+
+// fills table[coord][move] by decoding, moving and re-encoding every coordinate
+template <int N, typename Set, typename Get>
+static void buildMoveTable(uint16_t (&table)[N][MOVE_COUNT], Set set, Get get)
+{
+    for (int coord = 0; coord < N; ++coord)
+    {
+        CubieCube c;
+        set(c, coord);
+        for (int m = 0; m < MOVE_COUNT; ++m)
+        {
+            CubieCube moved = c;
+            moved.applyMove(m);
+            table[coord][m] = uint16_t(get(moved));
+        }
+    }
+}
+
+void initCoordTables()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        auto t0 = std::chrono::steady_clock::now();
+
+        buildMoveTable(twistMove, setTwistCoord, twistCoord);
+        buildMoveTable(flipMove, setFlipCoord, flipCoord);
+        buildMoveTable(cornerPermMove, setCornerPermCoord, cornerPermCoord);
+        buildMoveTable(sliceMove, setSliceCoord, sliceCoord);
+        for (int g = 0; g < EDGE_GROUPS; ++g)
+        {
+            buildMoveTable(edgeGroupMove[g],
+                [g](CubieCube& c, int coord) { setSingleEdgeGroup(c, g, coord); },
+                [g](const CubieCube& c) { return edgeGroupCoord(c, g); });
+            solvedEdgeGroup[g] = uint16_t(edgeGroupCoord(CubieCube(), g));
+
+            for (int coord = 0; coord < N_EDGE_GROUP; ++coord)
+            {
+                int ep[CubieCube::EDGES];
+                int used = placeEdgeGroup(ep, g, coord);
+                uint16_t slots = 0;
+                for (int i = 0; i < CubieCube::EDGES; ++i)
+                    if (used & (1 << i)) slots |= uint16_t(i << (4 * (ep[i] & 3)));
+                edgeGroupSlots[g][coord] = slots;
+            }
+        }
+
+        // piece counts for the heuristic
+        for (int t = 0; t < N_TWIST; ++t)
+        {
+            CubieCube c; setTwistCoord(c, t);
+            for (int i = 0; i < CubieCube::CORNERS; ++i) twistedCorners[t] += c.cornerOri(i) != 0;
+        }
+        for (int f = 0; f < N_FLIP; ++f)
+        {
+            CubieCube c; setFlipCoord(c, f);
+            for (int i = 0; i < CubieCube::EDGES; ++i) flippedEdges[f] += c.edgeOri(i) != 0;
+        }
+        for (int p = 0; p < N_CORNER_PERM; ++p)
+        {
+            CubieCube c; setCornerPermCoord(c, p);
+            for (int i = 0; i < CubieCube::CORNERS; ++i) misplacedCorners[p] += c.cornerPerm(i) != i;
+        }
+        for (int g = 0; g < EDGE_GROUPS; ++g)
+        {
+            for (int coord = 0; coord < N_EDGE_GROUP; ++coord)
+            {
+                CubieCube c; setSingleEdgeGroup(c, g, coord);
+                for (int i = 0; i < CubieCube::EDGES; ++i)
+                    if ((c.edgePerm(i) >> 2) == g && c.edgePerm(i) != i) ++misplacedGroupEdges[g][coord];
+            }
+        }
+
+        auto t1 = std::chrono::steady_clock::now();
+        g_buildMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    });
+}
+
+double coordTableBuildMs()
+{
+    return g_buildMs;
+}
+
+// ----- CoordCube -----
+
+CoordCube::CoordCube()
+{
+    for (int g = 0; g < EDGE_GROUPS; ++g) edgeGroup[g] = solvedEdgeGroup[g];
+}
+
+CoordCube::CoordCube(const CubieCube& c)
+{
+    twist      = uint16_t(twistCoord(c));
+    flip       = uint16_t(flipCoord(c));
+    cornerPerm = uint16_t(cornerPermCoord(c));
+    for (int g = 0; g < EDGE_GROUPS; ++g) edgeGroup[g] = uint16_t(edgeGroupCoord(c, g));
+}
+
+CubieCube CoordCube::toCubie() const
+{
+    CubieCube c;
+    setCornerPermCoord(c, cornerPerm);
+    int groups[EDGE_GROUPS] = { edgeGroup[0], edgeGroup[1], edgeGroup[2] };
+    setEdgeGroupCoords(c, groups);
+    setTwistCoord(c, twist);
+    setFlipCoord(c, flip);
+    return c;
+}
+
+// Orientation terms count every twisted corner and flipped edge, not only the
+// ones already in their slot. A turn still changes at most 4 of each, so the
+// bound stays admissible and is never weaker than the sticker version.
+int CoordCube::cubieHeuristic() const
+{
+    int misplacedEdges = misplacedGroupEdges[0][edgeGroup[0]] +
+                         misplacedGroupEdges[1][edgeGroup[1]] +
+                         misplacedGroupEdges[2][edgeGroup[2]];
+
+    auto ceil_div = [](int x, int d) { return (x + d - 1) / d; };
+
+    return std::max(
+        std::max(ceil_div(misplacedCorners[cornerPerm], 4), ceil_div(misplacedEdges, 4)),
+        std::max(ceil_div(twistedCorners[twist], 4), ceil_div(flippedEdges[flip], 4))
+    );
+}
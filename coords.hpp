@@ -0,0 +1,96 @@
+#ifndef COORDS_HPP
+#define COORDS_HPP
+
+#include "cubie.hpp"
+
+///// COORDINATES /////
+
+// Each coordinate numbers one aspect of a CubieCube. A move is then one
+// lookup per coordinate in an 18-column table instead of a cubie shuffle.
+
+static constexpr int N_TWIST        = 2187;  // corner orientation, 3^7
+static constexpr int N_FLIP         = 2048;  // edge orientation, 2^11
+static constexpr int N_CORNER_PERM  = 40320; // corner permutation, 8!
+static constexpr int N_SLICE        = 495;   // which slots hold the UD-slice edges, C(12,4)
+static constexpr int N_EDGE_GROUP   = 11880; // slots + order of four edges, 12*11*10*9
+static constexpr int EDGE_GROUPS    = 3;     // 0: U edges, 1: D edges, 2: UD-slice edges
+
+int  twistCoord(const CubieCube& c);
+int  flipCoord(const CubieCube& c);
+int  cornerPermCoord(const CubieCube& c);
+int  sliceCoord(const CubieCube& c);
+int  edgeGroupCoord(const CubieCube& c, int group);
+
+void setTwistCoord(CubieCube& c, int twist);
+void setFlipCoord(CubieCube& c, int flip);
+void setCornerPermCoord(CubieCube& c, int perm);
+void setSliceCoord(CubieCube& c, int slice);
+void setEdgeGroupCoords(CubieCube& c, const int groups[EDGE_GROUPS]);
+
+///// MOVE TABLES /////
+
+extern uint16_t twistMove[N_TWIST][MOVE_COUNT];
+extern uint16_t flipMove[N_FLIP][MOVE_COUNT];
+extern uint16_t cornerPermMove[N_CORNER_PERM][MOVE_COUNT];
+extern uint16_t sliceMove[N_SLICE][MOVE_COUNT];
+extern uint16_t edgeGroupMove[EDGE_GROUPS][N_EDGE_GROUP][MOVE_COUNT];
+extern uint16_t solvedEdgeGroup[EDGE_GROUPS];
+// slot of edge 4g+j for a group coordinate, 4 bits per edge
+extern uint16_t edgeGroupSlots[EDGE_GROUPS][N_EDGE_GROUP];
+
+inline int edgeSlotOf(const uint16_t groups[EDGE_GROUPS], int edge)
+{
+    return (edgeGroupSlots[edge >> 2][groups[edge >> 2]] >> (4 * (edge & 3))) & 0xF;
+}
+
+// flip of the edge in a slot, slot 11 is implied by parity
+inline int flipAtSlot(int flip, int slot)
+{
+    if (slot < CubieCube::EDGES - 1) return (flip >> (CubieCube::EDGES - 2 - slot)) & 1;
+    int parity = 0;
+    for (int f = flip; f; f &= f - 1) parity ^= 1;
+    return parity;
+}
+
+// builds every table once; later calls return immediately
+void initCoordTables();
+// wall time the build took, 0 before initCoordTables ran
+double coordTableBuildMs();
+
+///// COORDINATE CUBE /////
+
+// full cube state as six table-driven coordinates, 12 bytes
+struct CoordCube
+{
+    uint16_t twist = 0;
+    uint16_t flip = 0;
+    uint16_t cornerPerm = 0;
+    uint16_t edgeGroup[EDGE_GROUPS] = {};
+
+    CoordCube(); // solved, tables must be built
+    explicit CoordCube(const CubieCube& c);
+
+    CubieCube toCubie() const;
+
+    void applyMove(int move)
+    {
+        twist      = twistMove[twist][move];
+        flip       = flipMove[flip][move];
+        cornerPerm = cornerPermMove[cornerPerm][move];
+        for (int g = 0; g < EDGE_GROUPS; ++g) edgeGroup[g] = edgeGroupMove[g][edgeGroup[g]][move];
+    }
+    void applyMove(Face f, Turn t) { applyMove(f * 3 + t); }
+
+    bool isSolved() const
+    {
+        return twist == 0 && flip == 0 && cornerPerm == 0 &&
+               edgeGroup[0] == solvedEdgeGroup[0] && edgeGroup[1] == solvedEdgeGroup[1] &&
+               edgeGroup[2] == solvedEdgeGroup[2];
+    }
+
+    // cubieHeuristic bound, one small table lookup per coordinate
+    int cubieHeuristic() const;
+    int heuristic() const { return cubieHeuristic(); }
+};
+
+#endif // COORDS_HPP
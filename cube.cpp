@@ -1,16 +1,18 @@
-#include "cube.hpp"
+#include "stickermoves.hpp"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 ///// RUBIKSCUBE IMPLEMENTATION /////
 
 // solved cube constructor
-RubiksCube::RubiksCube()
+RubiksCube::RubiksCube() : stickers_(kSolvedStickers) {}
+
+RubiksCube::RubiksCube(const array<Color, STICKER_COUNT>& colors) : stickers_{}
 {
-    faces_[Up]    = Side(Color::White);
-    faces_[Down]  = Side(Color::Yellow);
-    faces_[Left]  = Side(Color::Orange);
-    faces_[Right] = Side(Color::Red);
-    faces_[Front] = Side(Color::Green);
-    faces_[Back]  = Side(Color::Blue);
+    for (int i = 0; i < STICKER_COUNT; ++i) stickers_[i] = uint8_t(colors[i]);
 }
 
 // randomizes cube with a series of random moves
@@ -29,133 +31,39 @@ RubiksCube::RubiksCube()
 //     }
 // }
 
-// core move dispatcher
-void RubiksCube::applyMove(Face f, Turn t)
-{
-    switch (f)
-    {
-    case Up:    rotateTop(t);    break;
-    case Down:  rotateBottom(t); break;
-    case Left:  rotateLeft(t);   break;
-    case Right: rotateRight(t);  break;
-    case Front: rotateFront(t);  break;
-    case Back:  rotateBack(t);   break;
-    default:    break;
-    }
-}
-
-///// FACE ROTATION HELPERS /////
-
-void RubiksCube::rotateTop(Turn t)
+// every move is a permutation of the 54 stickers
+void RubiksCube::applyMove(int move)
 {
-    Side &U = faces_[Up];
-    auto cwNeighbors = [this]() {
-        Side &F = faces_[Front], &R = faces_[Right], &B = faces_[Back], &L = faces_[Left];
-        Color tmp[Side::SIZE];
-        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = F.squares[0][i];
-        for (int i = 0; i < Side::SIZE; ++i) F.squares[0][i] = R.squares[0][i];
-        for (int i = 0; i < Side::SIZE; ++i) R.squares[0][i] = B.squares[0][i];
-        for (int i = 0; i < Side::SIZE; ++i) B.squares[0][i] = L.squares[0][i];
-        for (int i = 0; i < Side::SIZE; ++i) L.squares[0][i] = tmp[i];
-    };
-    switch (t) {
-    case CW: U.rotateCW(); cwNeighbors(); break;
-    case CCW: U.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
-    case Double: U.rotate180(); cwNeighbors(); cwNeighbors(); break;
-    }
+    applyStickerMoves(activeStickerKernel(), stickers_.data(), &allMoves[move], 1);
 }
 
-void RubiksCube::rotateBottom(Turn t)
+void RubiksCube::applyMoves(const vector<Move>& seq)
 {
-    Side &D = faces_[Down];
-    auto cwNeighbors = [this]() {
-        Side &F = faces_[Front], &R = faces_[Right], &B = faces_[Back], &L = faces_[Left];
-        Color tmp[Side::SIZE];
-        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = F.squares[Side::SIZE - 1][i];
-        for (int i = 0; i < Side::SIZE; ++i) F.squares[Side::SIZE - 1][i] = L.squares[Side::SIZE - 1][i];
-        for (int i = 0; i < Side::SIZE; ++i) L.squares[Side::SIZE - 1][i] = B.squares[Side::SIZE - 1][i];
-        for (int i = 0; i < Side::SIZE; ++i) B.squares[Side::SIZE - 1][i] = R.squares[Side::SIZE - 1][i];
-        for (int i = 0; i < Side::SIZE; ++i) R.squares[Side::SIZE - 1][i] = tmp[i];
-    };
-    switch (t) {
-    case CW: D.rotateCW(); cwNeighbors(); break;
-    case CCW: D.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
-    case Double: D.rotate180(); cwNeighbors(); cwNeighbors(); break;
-    }
+    applyStickerMoves(activeStickerKernel(), stickers_.data(), seq.data(), seq.size());
 }
 
-void RubiksCube::rotateLeft(Turn t)
+// each face a solid colour; centers never move, so that is one fixed state
+bool RubiksCube::isSolved() const
 {
-    Side &L = faces_[Left];
-    auto cwNeighbors = [this]() {
-        Side &U = faces_[Up], &F = faces_[Front], &D = faces_[Down], &B = faces_[Back];
-        Color tmp[Side::SIZE];
-        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[i][0];
-        for (int i = 0; i < Side::SIZE; ++i) U.squares[i][0] = B.squares[Side::SIZE - 1 - i][Side::SIZE - 1];
-        for (int i = 0; i < Side::SIZE; ++i) B.squares[i][Side::SIZE - 1] = D.squares[Side::SIZE - 1 - i][0];
-        for (int i = 0; i < Side::SIZE; ++i) D.squares[i][0] = F.squares[i][0];
-        for (int i = 0; i < Side::SIZE; ++i) F.squares[i][0] = tmp[i];
-    };
-    switch (t) {
-    case CW: L.rotateCW(); cwNeighbors(); break;
-    case CCW: L.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
-    case Double: L.rotate180(); cwNeighbors(); cwNeighbors(); break;
+#if defined(__SSE2__)
+    // all 64 bytes against the solved constant, padding included
+    __m128i same = _mm_set1_epi8(-1);
+    for (int k = 0; k < STICKER_STORAGE / 16; ++k)
+    {
+        const __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(stickers_.data()) + k);
+        const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(kSolvedStickers.data()) + k);
+        same = _mm_and_si128(same, _mm_cmpeq_epi8(a, b));
     }
+    return _mm_movemask_epi8(same) == 0xFFFF;
+#else
+    return std::memcmp(stickers_.data(), kSolvedStickers.data(), STICKER_STORAGE) == 0;
+#endif
 }
 
-void RubiksCube::rotateRight(Turn t)
+Side RubiksCube::face(Face input) const
 {
-    Side &R = faces_[Right];
-    auto cwNeighbors = [this]() {
-        Side &U = faces_[Up], &F = faces_[Front], &D = faces_[Down], &B = faces_[Back];
-        Color tmp[Side::SIZE];
-        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[i][Side::SIZE - 1];
-        for (int i = 0; i < Side::SIZE; ++i) U.squares[i][Side::SIZE - 1] = F.squares[i][Side::SIZE - 1];
-        for (int i = 0; i < Side::SIZE; ++i) F.squares[i][Side::SIZE - 1] = D.squares[i][Side::SIZE - 1];
-        for (int i = 0; i < Side::SIZE; ++i) D.squares[i][Side::SIZE - 1] = B.squares[Side::SIZE - 1 - i][0];
-        for (int i = 0; i < Side::SIZE; ++i) B.squares[i][0] = tmp[Side::SIZE - 1 - i];
-    };
-    switch (t) {
-    case CW: R.rotateCW(); cwNeighbors(); break;
-    case CCW: R.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
-    case Double: R.rotate180(); cwNeighbors(); cwNeighbors(); break;
-    }
+    Side s;
+    for (int r = 0; r < Side::SIZE; ++r)
+        for (int c = 0; c < Side::SIZE; ++c) s.squares[r][c] = sticker(input, r, c);
+    return s;
 }
-
-void RubiksCube::rotateFront(Turn t)
-{
-    Side &F = faces_[Front];
-    auto cwNeighbors = [this]() {
-        Side &U = faces_[Up], &D = faces_[Down], &L = faces_[Left], &R = faces_[Right];
-        Color tmp[Side::SIZE];
-        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[Side::SIZE - 1][i];
-        for (int i = 0; i < Side::SIZE; ++i) U.squares[Side::SIZE - 1][i] = L.squares[Side::SIZE - 1 - i][Side::SIZE - 1];
-        for (int i = 0; i < Side::SIZE; ++i) L.squares[i][Side::SIZE - 1] = D.squares[0][i];
-        for (int i = 0; i < Side::SIZE; ++i) D.squares[0][i] = R.squares[Side::SIZE - 1 - i][0];
-        for (int i = 0; i < Side::SIZE; ++i) R.squares[i][0] = tmp[i];
-    };
-    switch (t) {
-    case CW: F.rotateCW(); cwNeighbors(); break;
-    case CCW: F.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
-    case Double: F.rotate180(); cwNeighbors(); cwNeighbors(); break;
-    }
-}
-
-void RubiksCube::rotateBack(Turn t)
-{
-    Side &B = faces_[Back];
-    auto cwNeighbors = [this]() {
-        Side &U = faces_[Up], &D = faces_[Down], &L = faces_[Left], &R = faces_[Right];
-        Color tmp[Side::SIZE];
-        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[0][i];
-        for (int i = 0; i < Side::SIZE; ++i) U.squares[0][i] = R.squares[i][Side::SIZE - 1];
-        for (int i = 0; i < Side::SIZE; ++i) R.squares[i][Side::SIZE - 1] = D.squares[Side::SIZE - 1][Side::SIZE - 1 - i];
-        for (int i = 0; i < Side::SIZE; ++i) D.squares[Side::SIZE - 1][i] = L.squares[i][0];
-        for (int i = 0; i < Side::SIZE; ++i) L.squares[i][0] = tmp[Side::SIZE - 1 - i];
-    };
-    switch (t) {
-    case CW: B.rotateCW(); cwNeighbors(); break;
-    case CCW: B.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
-    case Double: B.rotate180(); cwNeighbors(); cwNeighbors(); break;
-    }
-}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "cubegeometry.hpp"
+
+bool cubieOnFaceLayer(int ix, int iy, int iz, Face f)
+{
+    switch(f){
+    case Front: return (iz ==  1);
+    case Back:  return (iz == -1);
+    case Right: return (ix ==  1);
+    case Left:  return (ix == -1);
+    case Up:    return (iy ==  1);
+    case Down:  return (iy == -1);
+    default:    return false;
+    }
+}
+
+int stickerAt(int ix, int iy, int iz, Face f)
+{
+    int row=0,col=0;
+    switch(f){
+    case Front: row = 1-iy; col = ix+1; break;
+    case Back: row = 1-iy; col = 1-ix; break;
+    case Right: row = 1-iy; col = 1-iz; break;
+    case Left: row = 1-iy; col = iz+1; break;
+    case Up: row = iz+1; col = ix+1; break;
+    case Down: row = 1-iz; col = ix+1; break;
+    default:    break;
+    }
+    if (row < 0) row = 0; else if (row > 2) row = 2;
+    if (col < 0) col = 0; else if (col > 2) col = 2;
+    return stickerIndex(f, row, col);
+}
+
+void axisForFace(Face f, float &ax, float &ay, float &az)
+{
+    ax = ay = az = 0.0f;
+    switch (f)
+    {
+    case Up:    ay = 1.0f; break;
+    case Down:  ay = -1.0f; break;
+    case Left:  ax = -1.0f; break;
+    case Right: ax = 1.0f;  break;
+    case Front: az = 1.0f;  break;
+    case Back:  az = -1.0f; break;
+    default: break;
+    }
+}
+
+bool calculateAnimAngle(bool active, const Move& move, float progress, float duration, float &outAngle)
+{
+    if (!active) return false;
+
+    float tmp = progress / duration;
+    if (tmp > 1.0f) tmp = 1.0f;
+    const float baseAngle = 90.0f;
+
+    // Standard CW logic
+    float faceSign = -1.0f;
+
+    switch (move.turn)
+    {
+    case CW: outAngle = faceSign * baseAngle * tmp; break;
+    case CCW: outAngle = -faceSign * baseAngle * tmp; break;
+    case Double: outAngle = 2.0f * faceSign * baseAngle * tmp; break;
+    }
+    return true;
+}
+
+void stickerRGBA(Color c, uint8_t out[4])
+{
+    static const uint8_t table[6][3] = {
+        {255,255,255}, {255,255,0}, {255,0,0}, {255,128,0}, {0,0,255}, {0,255,0}
+    };
+    static const uint8_t grey[3] = {128,128,128};
+    const uint8_t* rgb = unsigned(c) < 6 ? table[c] : grey;
+    out[0] = rgb[0]; out[1] = rgb[1]; out[2] = rgb[2]; out[3] = 255;
+}
+
+static CubeMesh buildCubeMesh()
+{
+    const float half = CUBIE_SIZE*0.5f;
+    const float stickerInset = 0.01f;
+    const float out = half + stickerInset;
+
+    // one quad per face of a cube of the given half size, pushed out to o
+    // along the face normal; corners run as the immediate-mode stickers did
+    struct Quad { float v[4][3]; };
+    auto faceQuad = [](Face f, float h, float o) {
+        const float p[6][4][3] = {
+            {{-h, o, h}, { h, o, h}, { h, o,-h}, {-h, o,-h}},     // Up
+            {{-h,-o,-h}, { h,-o,-h}, { h,-o, h}, {-h,-o, h}},     // Down
+            {{-o,-h, h}, {-o,-h,-h}, {-o, h,-h}, {-o, h, h}},     // Left
+            {{ o,-h,-h}, { o,-h, h}, { o, h, h}, { o, h,-h}},     // Right
+            {{-h,-h, o}, { h,-h, o}, { h, h, o}, {-h, h, o}},     // Front
+            {{ h,-h,-o}, {-h,-h,-o}, {-h, h,-o}, { h, h,-o}},     // Back
+        };
+        Quad q{};
+        for (int i = 0; i < 4; ++i) for (int k = 0; k < 3; ++k) q.v[i][k] = p[f][i][k];
+        return q;
+    };
+
+    CubeMesh mesh;
+    auto addQuad = [&](const Quad& q, int ix, int iy, int iz) {
+        uint8_t layers = 0;
+        for (int f = 0; f < Face::Count; ++f)
+            if (cubieOnFaceLayer(ix, iy, iz, Face(f))) layers |= uint8_t(1u << f);
+        for (int i = 0; i < 4; ++i) {
+            mesh.positions.push_back(q.v[i][0] + ix * CUBIE_SPACING);
+            mesh.positions.push_back(q.v[i][1] + iy * CUBIE_SPACING);
+            mesh.positions.push_back(q.v[i][2] + iz * CUBIE_SPACING);
+            mesh.layers.push_back(layers);
+        }
+    };
+
+    for (int ix=-1; ix<=1; ++ix)
+        for (int iy=-1; iy<=1; ++iy)
+            for (int iz=-1; iz<=1; ++iz)
+            {
+                if (ix == 0 && iy == 0 && iz == 0) continue; // hidden
+                for (int f = 0; f < Face::Count; ++f) addQuad(faceQuad(Face(f), half, half), ix, iy, iz);
+            }
+    mesh.stickerBase = int(mesh.layers.size());
+
+    struct Placed { int ix, iy, iz; };
+    Placed placed[STICKER_COUNT] = {};
+    for (int ix=-1; ix<=1; ++ix)
+        for (int iy=-1; iy<=1; ++iy)
+            for (int iz=-1; iz<=1; ++iz)
+                for (int f = 0; f < Face::Count; ++f)
+                    if (cubieOnFaceLayer(ix, iy, iz, Face(f))) placed[stickerAt(ix, iy, iz, Face(f))] = {ix, iy, iz};
+    for (int i = 0; i < STICKER_COUNT; ++i)
+        addQuad(faceQuad(Face(i / 9), half, out), placed[i].ix, placed[i].iy, placed[i].iz);
+    mesh.vertexCount = int(mesh.layers.size());
+    return mesh;
+}
+
+const CubeMesh& cubeMesh()
+{
+    static const CubeMesh mesh = buildCubeMesh();
+    return mesh;
+}
@@ -0,0 +1,45 @@
+#ifndef CUBEGEOMETRY_HPP
+#define CUBEGEOMETRY_HPP
+
+#include "cube.hpp"
+
+///// CUBE GEOMETRY /////
+
+// What the cube looks like, without any graphics API: the visualizer
+// uploads this to GL and the software renderer rasterizes it on the CPU,
+// so both draw the same cube the same way.
+
+inline constexpr float CUBE_HALF     = 1.0f;
+inline constexpr float CUBIE_SPACING = (2.0f * CUBE_HALF) / 3.0f;
+inline constexpr float CUBIE_SIZE    = CUBIE_SPACING * 0.92f;
+
+// Quads for the 26 visible cubie bodies and the 54 stickers, 4 vertices
+// each. Bodies come first, then the stickers in sticker order, so sticker
+// i is vertices stickerBase + 4i to stickerBase + 4i + 3.
+struct CubeMesh
+{
+    vector<float>   positions; // xyz per vertex
+    vector<uint8_t> layers;    // per vertex, bit f set when its cubie turns with face f
+    int vertexCount = 0;
+    int stickerBase = 0;
+};
+
+const CubeMesh& cubeMesh(); // built on first use
+
+// the cubie at grid position (ix,iy,iz), each -1..1, turns with face f
+bool cubieOnFaceLayer(int ix, int iy, int iz, Face f);
+
+// sticker index of the face-f sticker on the cubie at (ix,iy,iz)
+int stickerAt(int ix, int iy, int iz, Face f);
+
+// rotation axis of a face turn, pointing out of the face
+void axisForFace(Face f, float& ax, float& ay, float& az);
+
+// degrees the turning layer has rotated after progress of duration seconds,
+// false when no move is animating
+bool calculateAnimAngle(bool active, const Move& move, float progress, float duration, float& outAngle);
+
+// display colour of a sticker, opaque RGBA
+void stickerRGBA(Color c, uint8_t out[4]);
+
+#endif // CUBEGEOMETRY_HPP
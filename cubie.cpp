@@ -0,0 +1,244 @@
+#include "cubie.hpp"
+
+// ----- Sticker Geometry -----
+
+const CornerSlot kCornerSlots[8] =
+{
+    { { {Up,   2, 2}, {Right, 0, 0}, {Front, 0, 2} } }, // 0: UFR
+    { { {Up,   2, 0}, {Front, 0, 0}, {Left,  0, 2} } }, // 1: UFL
+    { { {Up,   0, 0}, {Left,  0, 0}, {Back,  0, 2} } }, // 2: UBL
+    { { {Up,   0, 2}, {Back,  0, 0}, {Right, 0, 2} } }, // 3: UBR
+    { { {Down, 0, 2}, {Front, 2, 2}, {Right, 2, 0} } }, // 4: DFR
+    { { {Down, 0, 0}, {Left,  2, 2}, {Front, 2, 0} } }, // 5: DFL
+    { { {Down, 2, 0}, {Back,  2, 2}, {Left,  2, 0} } }, // 6: DBL
+    { { {Down, 2, 2}, {Right, 2, 2}, {Back,  2, 0} } }  // 7: DBR
+};
+
+const EdgeSlot kEdgeSlots[12] =
+{
+    { { {Up,   2, 1}, {Front, 0, 1} } }, // 0: UF
+    { { {Up,   1, 2}, {Right, 0, 1} } }, // 1: UR
+    { { {Up,   0, 1}, {Back,  0, 1} } }, // 2: UB
+    { { {Up,   1, 0}, {Left,  0, 1} } }, // 3: UL
+    { { {Down, 0, 1}, {Front, 2, 1} } }, // 4: DF
+    { { {Down, 1, 2}, {Right, 2, 1} } }, // 5: DR
+    { { {Down, 2, 1}, {Back,  2, 1} } }, // 6: DB
+    { { {Down, 1, 0}, {Left,  2, 1} } }, // 7: DL
+    { { {Front, 1, 2}, {Right, 1, 0} } }, // 8: FR
+    { { {Front, 1, 0}, {Left,  1, 2} } }, // 9: FL
+    { { {Back,  1, 0}, {Right, 1, 2} } }, // 10: BR
+    { { {Back,  1, 2}, {Left,  1, 0} } }  // 11: BL
+};
+
+static Color stickerAt(const RubiksCube& cube, const StickerPos& sp)
+{
+    return cube.sticker(sp.f, sp.row, sp.col);
+}
+
+// ----- Sticker Conversion -----
+
+CubieCube::CubieCube()
+{
+    for (int i = 0; i < CORNERS; ++i) setCorner(i, i, 0);
+    for (int i = 0; i < EDGES; ++i)   setEdge(i, i, 0);
+}
+
+// reads every slot and finds which cubie sits there and how it is turned
+CubieCube::CubieCube(const RubiksCube& stickers) : CubieCube()
+{
+    // the solved colour of a sticker is its face's center
+    auto centerOf = [&](Face f) { return stickers.sticker(f, 1, 1); };
+
+    for (int i = 0; i < CORNERS; ++i)
+    {
+        Color cur[3];
+        for (int k = 0; k < 3; ++k) cur[k] = stickerAt(stickers, kCornerSlots[i].sticker[k]);
+
+        for (int j = 0; j < CORNERS; ++j)
+        {
+            bool found = false;
+            for (int ori = 0; ori < 3 && !found; ++ori)
+            {
+                found = true;
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (cur[(k + ori) % 3] != centerOf(kCornerSlots[j].sticker[k].f)) { found = false; break; }
+                }
+                if (found) setCorner(i, j, ori);
+            }
+            if (found) break;
+        }
+    }
+
+    for (int i = 0; i < EDGES; ++i)
+    {
+        Color c0 = stickerAt(stickers, kEdgeSlots[i].sticker[0]);
+        Color c1 = stickerAt(stickers, kEdgeSlots[i].sticker[1]);
+
+        for (int j = 0; j < EDGES; ++j)
+        {
+            Color s0 = centerOf(kEdgeSlots[j].sticker[0].f);
+            Color s1 = centerOf(kEdgeSlots[j].sticker[1].f);
+            if (c0 == s0 && c1 == s1) { setEdge(i, j, 0); break; }
+            if (c0 == s1 && c1 == s0) { setEdge(i, j, 1); break; }
+        }
+    }
+}
+
+// paints the cubies back onto a solved cube's stickers
+RubiksCube::RubiksCube(const CubieCube& cubies) : RubiksCube()
+{
+    for (int i = 0; i < CubieCube::CORNERS; ++i)
+    {
+        int j = cubies.cornerPerm(i), ori = cubies.cornerOri(i);
+        for (int k = 0; k < 3; ++k)
+        {
+            const StickerPos& dst = kCornerSlots[i].sticker[(k + ori) % 3];
+            Face home = kCornerSlots[j].sticker[k].f;
+            stickers_[stickerIndex(dst.f, dst.row, dst.col)] = stickers_[stickerIndex(home, 1, 1)];
+        }
+    }
+    for (int i = 0; i < CubieCube::EDGES; ++i)
+    {
+        int j = cubies.edgePerm(i), ori = cubies.edgeOri(i);
+        for (int k = 0; k < 2; ++k)
+        {
+            const StickerPos& dst = kEdgeSlots[i].sticker[(k + ori) % 2];
+            Face home = kEdgeSlots[j].sticker[k].f;
+            stickers_[stickerIndex(dst.f, dst.row, dst.col)] = stickers_[stickerIndex(home, 1, 1)];
+        }
+    }
+}
+
+// ----- Move Tables -----
+
+// each move as a cubie cube, read off the sticker implementation once
+struct CubieMoveTable
+{
+    uint8_t cornerSrc[MOVE_COUNT][CubieCube::CORNERS];
+    uint8_t cornerTwist[MOVE_COUNT][CubieCube::CORNERS];
+    uint8_t edgeSrc[MOVE_COUNT][CubieCube::EDGES];
+    uint8_t edgeFlip[MOVE_COUNT][CubieCube::EDGES];
+};
+
+static CubieMoveTable buildMoveTable()
+{
+    CubieMoveTable t{};
+    for (int m = 0; m < MOVE_COUNT; ++m)
+    {
+        RubiksCube moved;
+        moved.applyMove(allMoves[m].face, allMoves[m].turn);
+        CubieCube mc(moved);
+        for (int i = 0; i < CubieCube::CORNERS; ++i)
+        {
+            t.cornerSrc[m][i]   = uint8_t(mc.cornerPerm(i));
+            t.cornerTwist[m][i] = uint8_t(mc.cornerOri(i) << 3);
+        }
+        for (int i = 0; i < CubieCube::EDGES; ++i)
+        {
+            t.edgeSrc[m][i]  = uint8_t(mc.edgePerm(i));
+            t.edgeFlip[m][i] = uint8_t(mc.edgeOri(i) << 4);
+        }
+    }
+    return t;
+}
+
+static const CubieMoveTable kMoveTable = buildMoveTable();
+
+// packed corner byte + twist byte -> packed corner byte, avoids a % 3
+static uint8_t addTwist(uint8_t corner, uint8_t twist)
+{
+    int ori = (corner >> 3) + (twist >> 3);
+    if (ori >= 3) ori -= 3;
+    return uint8_t((corner & 7) | (ori << 3));
+}
+
+// ----- CubieCube Operations -----
+
+void CubieCube::applyMove(int move)
+{
+    const array<uint8_t, CORNERS> c = corners;
+    const array<uint8_t, EDGES>   e = edges;
+    for (int i = 0; i < CORNERS; ++i)
+        corners[i] = addTwist(c[kMoveTable.cornerSrc[move][i]], kMoveTable.cornerTwist[move][i]);
+    for (int i = 0; i < EDGES; ++i)
+        edges[i] = uint8_t(e[kMoveTable.edgeSrc[move][i]] ^ kMoveTable.edgeFlip[move][i]);
+}
+
+void CubieCube::multiply(const CubieCube& other)
+{
+    const array<uint8_t, CORNERS> c = corners;
+    const array<uint8_t, EDGES>   e = edges;
+    for (int i = 0; i < CORNERS; ++i)
+        corners[i] = addTwist(c[other.cornerPerm(i)], uint8_t(other.cornerOri(i) << 3));
+    for (int i = 0; i < EDGES; ++i)
+        edges[i] = uint8_t(e[other.edgePerm(i)] ^ (other.edgeOri(i) << 4));
+}
+
+CubieCube CubieCube::inverse() const
+{
+    CubieCube inv;
+    for (int i = 0; i < CORNERS; ++i)
+        inv.setCorner(cornerPerm(i), i, (3 - cornerOri(i)) % 3);
+    for (int i = 0; i < EDGES; ++i)
+        inv.setEdge(edgePerm(i), i, edgeOri(i));
+    return inv;
+}
+
+bool CubieCube::isSolved() const
+{
+    return *this == CubieCube();
+}
+
+bool CubieCube::isValid() const
+{
+    int seenCorners = 0, seenEdges = 0, twist = 0, flip = 0;
+    for (int i = 0; i < CORNERS; ++i) {
+        if (cornerOri(i) > 2) return false;
+        seenCorners |= 1 << cornerPerm(i);
+        twist += cornerOri(i);
+    }
+    for (int i = 0; i < EDGES; ++i) {
+        if (edgePerm(i) >= EDGES) return false;
+        seenEdges |= 1 << edgePerm(i);
+        flip += edgeOri(i);
+    }
+    if (seenCorners != 0xFF || seenEdges != 0xFFF) return false;
+    if (twist % 3 != 0 || flip % 2 != 0) return false;
+
+    // corner and edge permutations must have the same parity
+    auto parity = [](const int* p, int n) {
+        int inversions = 0;
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j)
+                if (p[i] > p[j]) ++inversions;
+        return inversions & 1;
+    };
+    int cp[CORNERS], ep[EDGES];
+    for (int i = 0; i < CORNERS; ++i) cp[i] = cornerPerm(i);
+    for (int i = 0; i < EDGES; ++i)   ep[i] = edgePerm(i);
+    return parity(cp, CORNERS) == parity(ep, EDGES);
+}
+
+// same bound as RubiksCube::cubieHeuristic, read straight off the cubies
+int CubieCube::cubieHeuristic() const
+{
+    int misplacedCorners = 0, misorientedCorners = 0;
+    int misplacedEdges = 0, misorientedEdges = 0;
+
+    for (int i = 0; i < CORNERS; ++i) {
+        if (cornerPerm(i) != i) ++misplacedCorners;
+        else if (cornerOri(i) != 0) ++misorientedCorners;
+    }
+    for (int i = 0; i < EDGES; ++i) {
+        if (edgePerm(i) != i) ++misplacedEdges;
+        else if (edgeOri(i) != 0) ++misorientedEdges;
+    }
+
+    auto ceil_div = [](int x, int d) { return (x + d - 1) / d; };
+
+    return std::max(
+        std::max(ceil_div(misplacedCorners, 4), ceil_div(misplacedEdges, 4)),
+        std::max(ceil_div(misorientedCorners, 4), ceil_div(misorientedEdges, 4))
+    );
+}
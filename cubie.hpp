@@ -0,0 +1,77 @@
+#ifndef CUBIE_HPP
+#define CUBIE_HPP
+
+#include "cube.hpp"
+
+///// STICKER GEOMETRY /////
+
+struct StickerPos
+{
+    Face f;
+    int row;
+    int col;
+};
+
+// corner stickers are listed clockwise (seen from outside) starting on U/D
+struct CornerSlot
+{
+    StickerPos sticker[3];
+};
+
+// edge stickers start on U/D, or on F/B for the middle layer
+struct EdgeSlot
+{
+    StickerPos sticker[2];
+};
+
+// Corner slots: 0: UFR, 1: UFL, 2: UBL, 3: UBR, 4: DFR, 5: DFL, 6: DBL, 7: DBR
+extern const CornerSlot kCornerSlots[8];
+
+// Edge slots: 0: UF, 1: UR, 2: UB, 3: UL, 4: DF, 5: DR, 6: DB, 7: DL,
+// 8: FR, 9: FL, 10: BR, 11: BL
+extern const EdgeSlot kEdgeSlots[12];
+
+///// CUBIE STATE /////
+
+// Cube stored per piece instead of per sticker: slot i holds a cubie id and
+// its twist/flip relative to the solved cube. One byte per piece, 20 total.
+struct CubieCube
+{
+    static constexpr int CORNERS = 8;
+    static constexpr int EDGES   = 12;
+
+    // corner byte: bits 0-2 cubie, bits 3-4 twist (0..2)
+    // edge byte:   bits 0-3 cubie, bit 4 flip
+    array<uint8_t, CORNERS> corners;
+    array<uint8_t, EDGES>   edges;
+
+    CubieCube(); // solved
+    explicit CubieCube(const RubiksCube& stickers);
+
+    RubiksCube toStickers() const { return RubiksCube(*this); }
+
+    int cornerPerm(int slot) const { return corners[slot] & 7; }
+    int cornerOri(int slot)  const { return corners[slot] >> 3; }
+    int edgePerm(int slot)   const { return edges[slot] & 15; }
+    int edgeOri(int slot)    const { return edges[slot] >> 4; }
+
+    void setCorner(int slot, int cubie, int ori) { corners[slot] = uint8_t(cubie | (ori << 3)); }
+    void setEdge(int slot, int cubie, int ori)   { edges[slot]   = uint8_t(cubie | (ori << 4)); }
+
+    void applyMove(int move);
+    void applyMove(Face f, Turn t) { applyMove(f * 3 + t); }
+
+    // this = this * other, i.e. other's permutation applied after ours
+    void multiply(const CubieCube& other);
+    CubieCube inverse() const;
+
+    bool isSolved() const;
+    bool isValid() const; // every piece once, twist/flip sums and parities match
+    int cubieHeuristic() const;
+    int heuristic() const { return cubieHeuristic(); }
+
+    bool operator==(const CubieCube& o) const { return corners == o.corners && edges == o.edges; }
+    bool operator!=(const CubieCube& o) const { return !(*this == o); }
+};
+
+#endif // CUBIE_HPP
@@ -1,109 +1,18 @@
-#include "cube.hpp"
-
-
-// ----- Heuristic Data Structures -----
-
-struct StickerPos 
-{
-    Face f;
-    int row;
-    int col;
-};
-
-struct CornerSlot 
-{
-    StickerPos sticker[3];
-};
-
-struct EdgeSlot 
-{
-    StickerPos sticker[2];
-};
-
-// Corner slots: each is a fixed *position* in the cube
-// 0: UFR, 1: UFL, 2: UBL, 3: UBR,
-// 4: DFR, 5: DFL, 6: DBL, 7: DBR
-static const CornerSlot kCornerSlots[8] =
-{
-    { { {Up,   2, 2}, {Front, 0, 2}, {Right, 0, 0} } }, // 0: UFR
-    { { {Up,   2, 0}, {Front, 0, 0}, {Left,  0, 2} } }, // 1: UFL
-    { { {Up,   0, 0}, {Back,  0, 2}, {Left,  0, 0} } }, // 2: UBL
-    { { {Up,   0, 2}, {Back,  0, 0}, {Right, 0, 2} } }, // 3: UBR
-    { { {Down, 0, 2}, {Front, 2, 2}, {Right, 2, 0} } }, // 4: DFR
-    { { {Down, 0, 0}, {Front, 2, 0}, {Left,  2, 2} } }, // 5: DFL
-    { { {Down, 2, 0}, {Back,  2, 2}, {Left,  2, 0} } }, // 6: DBL
-    { { {Down, 2, 2}, {Back,  2, 0}, {Right, 2, 2} } }  // 7: DBR
-};
-
-// Edge slots: 12 fixed positions
-// 0: UF, 1: UR, 2: UB, 3: UL, 4: DF, 5: DR, 6: DB, 7: DL,
-// 8: FR, 9: FL, 10: BR, 11: BL
-static const EdgeSlot kEdgeSlots[12] =
-{
-    { { {Up,   2, 1}, {Front, 0, 1} } }, // 0: UF
-    { { {Up,   1, 2}, {Right, 0, 1} } }, // 1: UR
-    { { {Up,   0, 1}, {Back,  0, 1} } }, // 2: UB
-    { { {Up,   1, 0}, {Left,  0, 1} } }, // 3: UL
-    { { {Down, 0, 1}, {Front, 2, 1} } }, // 4: DF
-    { { {Down, 1, 2}, {Right, 2, 1} } }, // 5: DR
-    { { {Down, 2, 1}, {Back,  2, 1} } }, // 6: DB
-    { { {Down, 1, 0}, {Left,  2, 1} } }, // 7: DL
-    { { {Front, 1, 2}, {Right, 1, 0} } }, // 8: FR
-    { { {Front, 1, 0}, {Left,  1, 2} } }, // 9: FL
-    { { {Back,  1, 0}, {Right, 1, 2} } }, // 10: BR
-    { { {Back,  1, 2}, {Left,  1, 0} } }  // 11: BL
-};
-
-// check if each face is a solid color
-bool RubiksCube::isSolved() const
-{
-    for (int fi = 0; fi < FACE_COUNT; ++fi)
-    {
-        const Side& s = faces_[fi];
-        Color center = s.getCenter();
-
-        for (int row = 0; row < Side::SIZE; ++row)
-        {
-            for (int col = 0; col < Side::SIZE; ++col)
-            {
-                if (s.squares[row][col] != center)
-                    return false;
-            }
-        }
-    }
-    return true;
-}
+#include "pdb.hpp"
+#include "threadpool.hpp"
+#include "idastar.hpp"
+#include <atomic>
+#include <chrono>
+#include <sstream>
 
 // ----- RubiksCube Heuristic Implementation -----
 
-// determines the max lower bound of moves required to solve the cube
-int RubiksCube::cubieHeuristic() const 
+// Determines the max lower bound of moves required to solve the cube. A
+// sticker's solved colour is its face's center, and the colours on one piece
+// are distinct, so a piece is in its slot when the colour sets (as bitmasks)
+// match and oriented when they match in order.
+int RubiksCube::cubieHeuristic() const
 {
-    using std::sort;
-
-    static bool initialized = false;
-    static Color solvedCornerColors[8][3];
-    static Color solvedEdgeColors[12][2];
-
-    if (!initialized) {
-        RubiksCube solved; // solved cube
-
-        // Record colors in solved state
-        for (int i = 0; i < 8; ++i) {
-            for (int k = 0; k < 3; ++k) {
-                const StickerPos &sp = kCornerSlots[i].sticker[k];
-                solvedCornerColors[i][k] = solved.faces_[sp.f].squares[sp.row][sp.col];
-            }
-        }
-        for (int i = 0; i < 12; ++i) {
-            for (int k = 0; k < 2; ++k) {
-                const StickerPos &sp = kEdgeSlots[i].sticker[k];
-                solvedEdgeColors[i][k] = solved.faces_[sp.f].squares[sp.row][sp.col];
-            }
-        }
-        initialized = true;
-    }
-
     int misplacedCorners = 0;
     int misorientedCorners = 0;
     int misplacedEdges = 0;
@@ -111,161 +20,340 @@ int RubiksCube::cubieHeuristic() const
 
     // Corners
     for (int i = 0; i < 8; ++i) {
-        Color cur[3];
+        int curSet = 0, solvedSet = 0;
+        bool sameOrder = true;
         for (int k = 0; k < 3; ++k) {
             const StickerPos &sp = kCornerSlots[i].sticker[k];
-            cur[k] = faces_[sp.f].squares[sp.row][sp.col];
-        }
-
-        array<int,3> setSolved{}, setCur{};
-        for (int k = 0; k < 3; ++k) {
-            setSolved[k] = static_cast<int>(solvedCornerColors[i][k]);
-            setCur[k]    = static_cast<int>(cur[k]);
-        }
-        sort(setSolved.begin(), setSolved.end());
-        sort(setCur.begin(), setCur.end());
-
-        if (setSolved != setCur) {
-            ++misplacedCorners;
-        } else {
-            bool sameOrder = true;
-            for (int k = 0; k < 3; ++k) {
-                if (cur[k] != solvedCornerColors[i][k]) {
-                    sameOrder = false;
-                    break;
-                }
-            }
-            if (!sameOrder) ++misorientedCorners;
+            Color cur = sticker(sp.f, sp.row, sp.col), solved = sticker(sp.f, 1, 1);
+            curSet |= 1 << cur;
+            solvedSet |= 1 << solved;
+            sameOrder &= cur == solved;
         }
+        if (curSet != solvedSet) ++misplacedCorners;
+        else if (!sameOrder) ++misorientedCorners;
     }
 
     // Edges
     for (int i = 0; i < 12; ++i) {
-        Color cur[2];
-        for (int k = 0; k < 2; ++k) {
-            const StickerPos &sp = kEdgeSlots[i].sticker[k];
-            cur[k] = faces_[sp.f].squares[sp.row][sp.col];
-        }
-
-        int s0 = static_cast<int>(solvedEdgeColors[i][0]);
-        int s1 = static_cast<int>(solvedEdgeColors[i][1]);
-        int c0 = static_cast<int>(cur[0]);
-        int c1 = static_cast<int>(cur[1]);
+        const StickerPos &a = kEdgeSlots[i].sticker[0], &b = kEdgeSlots[i].sticker[1];
+        Color c0 = sticker(a.f, a.row, a.col), c1 = sticker(b.f, b.row, b.col);
+        Color s0 = sticker(a.f, 1, 1), s1 = sticker(b.f, 1, 1);
 
-        bool setMatch = ((s0 == c0 && s1 == c1) || (s0 == c1 && s1 == c0));
-
-        if (!setMatch) {
-            ++misplacedEdges;
-        } else {
-            bool sameOrder = (s0 == c0 && s1 == c1);
-            if (!sameOrder) ++misorientedEdges;
-        }
+        if (c0 == s0 && c1 == s1) continue;
+        if (c0 == s1 && c1 == s0) ++misorientedEdges;
+        else ++misplacedEdges;
     }
 
     auto ceil_div = [](int x, int d) {
         return (x + d - 1) / d;
     };
 
-    int h_pos_corners = ceil_div(misplacedCorners, 4);
-    int h_pos_edges = ceil_div(misplacedEdges, 4);
-    int h_ori_corners = ceil_div(misorientedCorners, 4);
-    int h_ori_edges = ceil_div(misorientedEdges, 4);
-
-    int h = std::max(
-        std::max(h_pos_corners, h_pos_edges),
-        std::max(h_ori_corners, h_ori_edges)
+    return std::max(
+        std::max(ceil_div(misplacedCorners, 4), ceil_div(misplacedEdges, 4)),
+        std::max(ceil_div(misorientedCorners, 4), ceil_div(misorientedEdges, 4))
     );
+}
+
+// ----- Search Statistics -----
+
+long long SearchStats::totalNodes() const
+{
+    long long n = 0;
+    for (const SearchIteration& it : iterations) n += it.nodes;
+    return n;
+}
 
-    if (h < 0) h = 0;
-    return h;
+double SearchStats::totalMs() const
+{
+    double ms = 0.0;
+    for (const SearchIteration& it : iterations) ms += it.ms;
+    return ms;
+}
+
+double SearchStats::duplicateRate() const
+{
+    // every expanded node considers all 18 moves
+    long long generated = totalNodes() * MOVE_COUNT;
+    return generated > 0 ? double(prunedOpposite) / generated : 0.0;
+}
+
+std::string SearchStats::summary() const
+{
+    static const char* kOutcomes[] = { "not run", "solved", "already solved",
+                                       "depth cap reached", "iteration cap reached", "cancelled" };
+    std::ostringstream out;
+    for (const SearchIteration& it : iterations)
+        out << "  threshold " << it.threshold << ": " << it.nodes << " nodes, " << it.ms << " ms\n";
+    out << "  " << kOutcomes[outcome] << " at threshold " << finalThreshold;
+    if (ttHits + ttMisses > 0)
+        out << ", transposition table " << ttHits << " hits, " << ttMisses << " misses, "
+            << ttReplaces << " replaced";
+#if RUBIK_SEARCH_STATS
+    out << ", " << totalNodes() << " nodes, " << heuristicCalls << " heuristic calls, pruned "
+        << prunedThreshold << " by f, " << prunedSameFace << " same face, "
+        << prunedOpposite << " commuting (" << 100.0 * duplicateRate() << "% of successors), "
+        << prunedDepthCap << " by depth cap";
+#endif
+    out << "\n";
+    return out.str();
 }
 
 // ----- IDA* Solver -----
 
-vector<Move> RubiksCube::solveIDAStar(int maxIterations, int iterationDepth) const
+vector<Move> RubiksCube::solveIDAStar(int maxIterations, int iterationDepth, HeuristicKind kind) const
 {
-    if (isSolved()) return {};
+    SearchOptions options;
+    options.heuristic = kind;
+    return solveIDAStar(maxIterations, iterationDepth, options);
+}
 
-    const int INF = std::numeric_limits<int>::max();
-    const int maxDepth = iterationDepth;
+// searches on table-driven coordinates; stickers are only touched for the conversion
+vector<Move> RubiksCube::solveIDAStar(int maxIterations, int iterationDepth, const SearchOptions& options) const
+{
+    SearchStats* stats = options.stats;
+    if (stats) stats->clear();
+    if (isSolved()) {
+        if (stats) { stats->outcome = SearchAlreadySolved; stats->finalThreshold = 0; }
+        return {};
+    }
 
-    RubiksCube start = *this;
+    const int maxDepth = std::min(iterationDepth, MAX_SEARCH_DEPTH);
+    const HeuristicKind kind = options.heuristic;
 
-    static const Move allMoves[] = {
-        {Up,    CW}, {Up,    CCW}, {Up,    Double},
-        {Down,  CW}, {Down,  CCW}, {Down,  Double},
-        {Left,  CW}, {Left,  CCW}, {Left,  Double},
-        {Right, CW}, {Right, CCW}, {Right, Double},
-        {Front, CW}, {Front, CCW}, {Front, Double},
-        {Back,  CW}, {Back,  CCW}, {Back,  Double}
-    };
+    initCoordTables();
+    CoordCube start{CubieCube(*this)};
 
-    // gives move to invert to restore path
-    auto inverseOf = [](const Move& m) -> Move
-    {
-        Move tmp = m;
-        if (tmp.turn == CW)       tmp.turn = CCW;
-        else if (tmp.turn == CCW) tmp.turn = CW;
-        return tmp;
+    // Pattern tables that are unavailable drop out and leave the cubie bound.
+    // Building one can take a while, so a cancel stops that too.
+    const std::atomic<bool>* cancel = options.progress ? &options.progress->cancel : nullptr;
+    const bool useCorners = kind != HeuristicCubie && initCornerPDB(cancel);
+    const bool useEdges   = kind == HeuristicCornersEdges && initEdgePDBs(cancel);
+    if (cancel && cancel->load()) {
+        if (stats) { stats->outcome = SearchCancelled; stats->finalThreshold = 0; }
+        return {};
+    }
+    const PatternDatabase& corners = cornerPDB();
+    auto heuristicOf = [&](const CoordCube& c) {
+        int h = c.heuristic();
+        if (useCorners) h = std::max(h, corners.get(cornerIndex(c)));
+        if (useEdges) {
+            h = std::max(h, edgePDB(0).get(edgePattern(0).index(c)));
+            h = std::max(h, edgePDB(1).get(edgePattern(1).index(c)));
+        }
+        return h;
     };
 
-    std::vector<Move> path;
-    int threshold = start.heuristic();
+    const int threads = options.threads > 0 ? options.threads : int(std::thread::hardware_concurrency());
+    const bool rootSplit = threads > 1 && maxDepth >= 2;
+
+    // The budget is the total for the solve: the caller's table, or else
+    // transpositionBytes. A sequential search makes a table for this solve
+    // only when the caller did not provide one; the root split divides the
+    // budget among its workers instead (below).
+    TranspositionTable* table = options.transposition;
+    const size_t tableBudget = table ? table->bytes() : options.transpositionBytes;
+    std::unique_ptr<TranspositionTable> ownTable;
+    if (!table && tableBudget > 0 && !rootSplit) {
+        ownTable = std::make_unique<TranspositionTable>(tableBudget);
+        table = ownTable.get();
+    }
 
-    // Recursive DFS
-    std::function<int(RubiksCube&, int, int, const Move&)> dfs;
-    dfs = [&](RubiksCube& cube, int g, int curThreshold, const Move& prevMove) -> int
+    using Clock = std::chrono::steady_clock;
+    auto recordPass = [&]([[maybe_unused]] int passThreshold, const SearchTally& t, [[maybe_unused]] Clock::time_point t0)
     {
-        // global heuristics formula
-        int h = cube.heuristic();
-        int f = g + h;
+        if (table) table->addCounts(t.ttHits, t.ttMisses, t.ttReplaces);
+        if (!stats) return;
+        stats->ttHits += t.ttHits; stats->ttMisses += t.ttMisses; stats->ttReplaces += t.ttReplaces;
+#if RUBIK_SEARCH_STATS
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        stats->iterations.push_back({passThreshold, t.nodes, ms});
+        stats->heuristicCalls  += t.heuristicCalls;
+        stats->prunedThreshold += t.prunedThreshold;
+        stats->prunedSameFace  += t.prunedSameFace;
+        stats->prunedOpposite  += t.prunedOpposite;
+        stats->prunedDepthCap  += t.prunedDepthCap;
+#endif
+    };
+    auto finish = [&](SearchOutcome outcome, int finalThreshold)
+    {
+        if (stats) { stats->outcome = outcome; stats->finalThreshold = finalThreshold; }
+    };
 
-        // important checks
-        if (f > curThreshold) return f;
-        if (cube.isSolved()) return -1;
-        if (g >= maxDepth) return INF;
+    using Kernel = IDAStarKernel<CoordCube, decltype(heuristicOf)>;
+    constexpr int INF = Kernel::INF;
 
-        // keeps track of smallest f value over threshold for next threshold
-        int minNext = INF;
+    int threshold = heuristicOf(start);
 
-        // searches all moves
-        for (const Move& m : allMoves)
-        {
-            // move redundancy check
-            if (prevMove.face != Face::Count && m.face == prevMove.face) continue;
+    auto toMoves = [](const uint8_t* moves, int length) {
+        vector<Move> out(length);
+        for (int i = 0; i < length; ++i) out[i] = allMoves[moves[i]];
+        return out;
+    };
 
-            cube.applyMove(m.face, m.turn);
-            path.push_back(m);
+    // hands the kernel's nearest approach, after a root prefix, to the caller
+    SearchProgress* progress = options.progress;
+    auto offerPartial = [&](const uint8_t* prefix, int prefixLength, const Kernel& kernel) {
+        if (!progress || kernel.bestH() == INF) return;
+        vector<Move> moves = toMoves(prefix, prefixLength);
+        for (int i = 0; i < kernel.bestLength(); ++i) moves.push_back(allMoves[kernel.bestPath()[i]]);
+        progress->offerPartial(moves, kernel.bestH());
+    };
 
-            // recursive
-            int tmp = dfs(cube, g + 1, curThreshold, m);
+    if (!rootSplit)
+    {
+        Kernel kernel(heuristicOf, maxDepth, table);
+        kernel.setProgress(progress);
+        int iteration = 0;
+        while (true)
+        {
+            SearchTally tally;
+            Clock::time_point t0 = Clock::now();
+            if (table) table->newIteration();
+            if (progress) progress->threshold.store(threshold, std::memory_order_relaxed);
+            int tmp = kernel.search(start, 0, threshold, Face::Count, tally);
+            recordPass(threshold, tally, t0);
+
+            if (tmp == Kernel::FOUND) {
+                finish(SearchSolved, threshold);
+                return toMoves(kernel.path(), kernel.pathLength());
+            }
+            offerPartial(nullptr, 0, kernel);
+            if (kernel.cancelled()) { finish(SearchCancelled, threshold); return {}; }
+            if (tmp == INF) { finish(SearchDepthCap, threshold); return {}; }
 
-            if (tmp == -1) return -1;
-            if (tmp < minNext) minNext = tmp;
+            threshold = tmp;
+            ++iteration;
 
-            // undoes move after backtracking
-            path.pop_back();
-            Move invMove = inverseOf(m);
-            cube.applyMove(invMove.face, invMove.turn);
+            if (maxIterations > 0 && iteration >= maxIterations) { finish(SearchIterationCap, threshold); return {}; }
         }
-        return minNext;
+    }
+
+    // Root split: the depth-1 nodes are checked here in move order and each
+    // live one fans out into its depth-2 children (243 at most), which
+    // become pool tasks. Items keep DFS order, so taking the lowest solved
+    // item returns exactly what the sequential search would.
+    struct RootItem
+    {
+        uint8_t moves[MAX_SEARCH_DEPTH]; // the root prefix, then the task's solution
+        int length;
+        int value; // settled result, or INF until the task has run
+        bool task;
     };
 
+    // Every task probes a table of its own, taken from a free list of one
+    // per worker. With one shared table a task could prune a state that a
+    // later task reached first and was then aborted from, and the answer
+    // would depend on timing. Private tables keep each task's search, and so
+    // the result, the same as the sequential one, at the cost of a state
+    // shared by two tasks being searched by both. The worker tables split
+    // the budget and are all made here, up front, so the solve's footprint
+    // is the budget however the tasks land; a caller's table only collects
+    // the counts.
+    vector<std::unique_ptr<TranspositionTable>> freeTables;
+    if (tableBudget > 0)
+        for (int i = 0; i < threads; ++i)
+            freeTables.push_back(std::make_unique<TranspositionTable>(std::max(tableBudget / threads, sizeof(uint64_t))));
+
+    WorkStealingPool pool(threads);
+    vector<RootItem> items;
+    items.reserve(MOVE_COUNT + 243);
     int iteration = 0;
     while (true)
     {
-        path.clear();
-        // purely used to substitute input
-        Move dummyPrev{ Face::Count, CW };
+        SearchTally passTally;
+        std::mutex tallyLock;
+        Clock::time_point t0 = Clock::now();
+        if (progress) progress->threshold.store(threshold, std::memory_order_relaxed);
+
+        // the root and depth-1 checks stand in for the first two kernel levels
+        SEARCH_STAT(++passTally.heuristicCalls; ++passTally.nodes);
+        items.clear();
+        for (int m1 = 0; m1 < MOVE_COUNT; ++m1)
+        {
+            CoordCube c1 = start;
+            c1.applyMove(m1);
+
+            int f = 1 + heuristicOf(c1);
+            SEARCH_STAT(++passTally.heuristicCalls);
+            if (f > threshold)    { SEARCH_STAT(++passTally.prunedThreshold); items.push_back({{uint8_t(m1)}, 1, f, false}); continue; }
+            if (c1.isSolved())    { items.push_back({{uint8_t(m1)}, 1, Kernel::FOUND, false}); continue; }
+
+            const MoveSuccessors& next = kMoveSuccessors[m1 / 3];
+            SEARCH_STAT(++passTally.nodes; passTally.prunedSameFace += next.skippedSameFace;
+                        passTally.prunedOpposite += next.skippedOpposite);
+            for (int i = 0; i < next.count; ++i)
+                items.push_back({{uint8_t(m1), next.moves[i]}, 2, INF, true});
+        }
+
+        std::atomic<int> solvedTask{INF};
+        std::atomic<int> nextThreshold{INF};
+        auto reduceMin = [](std::atomic<int>& target, int value) {
+            int cur = target.load(std::memory_order_relaxed);
+            while (value < cur && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+        };
+
+        for (int i = 0; i < int(items.size()); ++i)
+        {
+            if (items[i].task) continue;
+            if (items[i].value == Kernel::FOUND) reduceMin(solvedTask, i);
+            else reduceMin(nextThreshold, items[i].value);
+        }
+
+        pool.run(int(items.size()), [&](int i)
+        {
+            RootItem& item = items[i];
+            if (!item.task || solvedTask.load(std::memory_order_relaxed) < i) return;
 
-        int tmp = dfs(start, 0, threshold, dummyPrev);
+            CoordCube cube = start;
+            cube.applyMove(item.moves[0]);
+            cube.applyMove(item.moves[1]);
 
-        if (tmp == -1) return path;
-        if (tmp == INF) return {};
+            std::unique_ptr<TranspositionTable> taskTable;
+            if (tableBudget > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(tallyLock);
+                    taskTable = std::move(freeTables.back());
+                    freeTables.pop_back();
+                }
+                taskTable->newIteration();
+            }
+
+            Kernel kernel(heuristicOf, maxDepth, taskTable.get());
+            kernel.setAbort(&solvedTask, i);
+            kernel.setProgress(progress);
+            SearchTally tally;
+            int tmp = kernel.search(cube, 2, threshold, item.moves[1] / 3, tally);
+            item.value = tmp;
+            if (tmp != Kernel::FOUND) offerPartial(item.moves, 2, kernel);
+            if (tmp == Kernel::FOUND)
+            {
+                for (int k = 0; k < kernel.pathLength(); ++k) item.moves[2 + k] = kernel.path()[k];
+                item.length = 2 + kernel.pathLength();
+                reduceMin(solvedTask, i);
+            }
+            else reduceMin(nextThreshold, tmp);
+
+            std::lock_guard<std::mutex> guard(tallyLock);
+            passTally.add(tally);
+            if (taskTable) freeTables.push_back(std::move(taskTable));
+        });
+        recordPass(threshold, passTally, t0);
+
+        int solved = solvedTask.load();
+        if (solved != INF) {
+            finish(SearchSolved, threshold);
+            return toMoves(items[solved].moves, items[solved].length);
+        }
+
+        if (progress && progress->cancel.load()) { finish(SearchCancelled, threshold); return {}; }
+
+        int tmp = nextThreshold.load();
+        if (tmp == INF) { finish(SearchDepthCap, threshold); return {}; }
 
         threshold = tmp;
         ++iteration;
 
-        if (maxIterations > 0 && iteration >= maxIterations) return {};
+        if (maxIterations > 0 && iteration >= maxIterations) { finish(SearchIterationCap, threshold); return {}; }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,195 @@
+#ifndef IDASTAR_HPP
+#define IDASTAR_HPP
+
+#include "transposition.hpp"
+#include <atomic>
+#include <limits>
+
+///// IDA* KERNEL /////
+
+static constexpr int MAX_SEARCH_DEPTH = 64;
+
+// per pass counts; parallel tasks keep their own and merge when done
+struct SearchTally
+{
+    long long nodes = 0, heuristicCalls = 0, prunedThreshold = 0;
+    long long prunedSameFace = 0, prunedOpposite = 0, prunedDepthCap = 0;
+    long long ttHits = 0, ttMisses = 0, ttReplaces = 0;
+
+    void add(const SearchTally& o)
+    {
+        nodes += o.nodes; heuristicCalls += o.heuristicCalls; prunedThreshold += o.prunedThreshold;
+        prunedSameFace += o.prunedSameFace; prunedOpposite += o.prunedOpposite;
+        prunedDepthCap += o.prunedDepthCap;
+        ttHits += o.ttHits; ttMisses += o.ttMisses; ttReplaces += o.ttReplaces;
+    }
+};
+
+// One bounded depth-first pass of IDA*, run on an explicit stack of frames
+// so the heuristic and applyMove inline into the loop. Each frame keeps its
+// own copy of the cube, so backtracking is a pop rather than an inverse move.
+// Everything lives inside the kernel object: a pass never touches the heap.
+//
+// Cube needs applyMove(int), isSolved() and a stateKey(cube, lastFace)
+// overload when a transposition table is used; Heuristic is any callable
+// returning a lower bound for a Cube.
+template <typename Cube, typename Heuristic>
+class IDAStarKernel
+{
+public:
+    static constexpr int FOUND = -1;
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+    IDAStarKernel(const Heuristic& heuristic, int maxDepth, TranspositionTable* table)
+        : heuristic_(heuristic), maxDepth_(maxDepth), table_(table) {}
+
+    // a parallel task gives up once a lower task index has solved
+    void setAbort(const std::atomic<int>* solvedTask, int task) { solvedTask_ = solvedTask; task_ = task; }
+
+    // publish node counts to progress, stop on its cancel flag and remember
+    // the path that came nearest solved
+    void setProgress(SearchProgress* progress) { progress_ = progress; }
+
+    // Searches below root, reached after rootG moves ending on rootLastFace
+    // (Face::Count for none). Returns FOUND with the moves after root in
+    // path()[0, pathLength()), else the smallest f above the threshold or INF.
+    int search(const Cube& root, int rootG, int threshold, int rootLastFace, SearchTally& tally)
+    {
+        // a cancel may already be pending, e.g. for a queued parallel task
+        if (progress_) report();
+        const int value = run(root, rootG, threshold, rootLastFace, tally);
+        if (progress_) report();
+        return value;
+    }
+
+    const uint8_t* path() const { return path_; }
+    int pathLength() const { return pathLength_; }
+
+    // with progress set: whether cancel stopped the search, and the path
+    // below root with the lowest heuristic over every search() so far
+    bool cancelled() const { return cancelled_; }
+    int bestH() const { return bestH_; }
+    const uint8_t* bestPath() const { return bestPath_; }
+    int bestLength() const { return bestLength_; }
+
+private:
+    static constexpr int REPORT_INTERVAL = 1 << 14; // nodes between progress updates, well under a millisecond
+
+    struct Frame
+    {
+        Cube cube;
+        int  lastFace;
+        int  next;    // successor index to try next
+        int  minNext; // smallest f over the threshold below this frame
+    };
+
+    int run(const Cube& root, int rootG, int threshold, int rootLastFace, SearchTally& tally)
+    {
+        threshold_ = threshold;
+        rootG_ = rootG;
+        pathLength_ = 0;
+
+        int value;
+        if (!enter(0, root, rootLastFace, tally, value)) return value;
+
+        int depth = 0;
+        while (true)
+        {
+            Frame& frame = frames_[depth];
+            const MoveSuccessors& next = kMoveSuccessors[frame.lastFace];
+
+            if (frame.next < next.count)
+            {
+                const int m = next.moves[frame.next++];
+                Cube child = frame.cube;
+                child.applyMove(m);
+                path_[depth] = uint8_t(m);
+
+                if (enter(depth + 1, child, m / 3, tally, value)) { ++depth; continue; }
+                if (value == FOUND) { pathLength_ = depth + 1; return FOUND; }
+                if (value < frame.minNext) frame.minNext = value;
+                continue;
+            }
+
+            // every successor searched, hand the frame's minimum to its parent
+            value = frame.minNext;
+            if (depth == 0) return value;
+            --depth;
+            if (value < frames_[depth].minNext) frames_[depth].minNext = value;
+        }
+    }
+
+    void report()
+    {
+        progress_->nodes.fetch_add(unreported_, std::memory_order_relaxed);
+        unreported_ = 0;
+        if (progress_->cancel.load(std::memory_order_relaxed)) cancelled_ = true;
+    }
+
+    // true when the node needs expanding and now sits at frames_[depth];
+    // otherwise value holds what the node settles to
+    bool enter(int depth, const Cube& cube, int lastFace, SearchTally& tally, int& value)
+    {
+        if (solvedTask_ && solvedTask_->load(std::memory_order_relaxed) < task_) { value = INF; return false; }
+        if (progress_)
+        {
+            if (++unreported_ >= REPORT_INTERVAL) report();
+            if (cancelled_) { value = INF; return false; }
+        }
+
+        const int g = rootG_ + depth;
+        const int h = heuristic_(cube);
+        const int f = g + h;
+        SEARCH_STAT(++tally.heuristicCalls);
+
+        if (progress_ && h < bestH_)
+        {
+            bestH_ = h;
+            bestLength_ = depth;
+            for (int i = 0; i < depth; ++i) bestPath_[i] = path_[i];
+        }
+
+        if (f > threshold_) { SEARCH_STAT(++tally.prunedThreshold); value = f; return false; }
+        if (cube.isSolved()) { value = FOUND; return false; }
+        if (g >= maxDepth_) { SEARCH_STAT(++tally.prunedDepthCap); value = INF; return false; }
+
+        // reached earlier in this pass with at least as much budget left
+        if (table_)
+        {
+            switch (table_->visit(stateKey(cube, lastFace), g)) {
+            case TranspositionTable::Duplicate: ++tally.ttHits; value = INF; return false;
+            case TranspositionTable::Replaced:  ++tally.ttMisses; ++tally.ttReplaces; break;
+            case TranspositionTable::Miss:      ++tally.ttMisses; break;
+            }
+        }
+        SEARCH_STAT(++tally.nodes);
+        SEARCH_STAT(tally.prunedSameFace += kMoveSuccessors[lastFace].skippedSameFace;
+                    tally.prunedOpposite += kMoveSuccessors[lastFace].skippedOpposite);
+
+        Frame& frame = frames_[depth];
+        frame.cube = cube;
+        frame.lastFace = lastFace;
+        frame.next = 0;
+        frame.minNext = INF;
+        return true;
+    }
+
+    const Heuristic&           heuristic_;
+    const int                  maxDepth_;
+    TranspositionTable*        table_;
+    const std::atomic<int>*    solvedTask_ = nullptr;
+    int                        task_ = 0;
+    SearchProgress*            progress_ = nullptr;
+    int                        unreported_ = 0;
+    bool                       cancelled_ = false;
+    int                        bestH_ = INF;
+    int                        bestLength_ = 0;
+    int                        threshold_ = 0;
+    int                        rootG_ = 0;
+    int                        pathLength_ = 0;
+    Frame                      frames_[MAX_SEARCH_DEPTH + 1];
+    uint8_t                    path_[MAX_SEARCH_DEPTH];
+    uint8_t                    bestPath_[MAX_SEARCH_DEPTH];
+};
+
+#endif // IDASTAR_HPP
@@ -4,10 +4,21 @@
 #include <string>
 #include <functional>
 #include <random>
-#include "cube.hpp"
+#include <memory>
+#include <cstdio>
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+#include <atomic>
+#include <future>
+#include "pdb.hpp"
+#include "visuals.hpp"
+#include "solver.hpp"
+#include "solutioncache.hpp"
 
 // ---------- Globals ----------
 RubiksCube g_cube;
+CubeRenderer g_cubeRenderer;
 
 float g_camAngleX = 30.0f;
 float g_camAngleY = -30.0f;
@@ -27,10 +38,57 @@ float g_moveProgress = 0.0f;
 const float g_moveDuration = 0.30f;
 int   g_lastTimeMs = 0;
 
+// Frames are driven by a GLUT timer that runs only while something moves or
+// a solve is in flight; otherwise the window redraws just on input.
+int   g_targetFps = 60;
+bool  g_frameTimerRunning = false;
+int   g_nextFrameMs = 0;
+
+// optional overlay with frame timings and process CPU use
+bool  g_showHud = false;
+struct FrameStats {
+    double drawMs = 0.0;     // display() time, smoothed
+    double intervalMs = 0.0; // time between frames, smoothed
+    double cpuPercent = 0.0; // process CPU time over wall time, last sample
+    std::chrono::steady_clock::time_point lastFrame;
+    std::chrono::steady_clock::time_point sampleWall;
+    std::clock_t sampleCpu = 0;
+    long long frames = 0;
+};
+FrameStats g_frameStats;
+
+// Background solve, polled each frame; IDA* is cancelled once it runs past
+// the budget, the two-phase search keeps to its own
+std::unique_ptr<AsyncSolve> g_solveJob;
+int  g_solveStartMs = 0;
+int  g_solveBudgetMs = 10000;
+bool g_solveCancelledByUser = false;
+
+// Pattern tables for the chosen heuristic, built off the UI thread when the
+// heuristic is picked; an IDA* solve asked for meanwhile starts once they
+// are ready. Cancelling keeps the finished layers for the next build.
+struct TableBuild
+{
+    HeuristicKind     kind = HeuristicCubie;
+    std::atomic<bool> cancel{false};
+    std::future<bool> done;
+    ~TableBuild() { cancel.store(true); if (done.valid()) done.wait(); }
+};
+std::unique_ptr<TableBuild> g_tableJob;
+int  g_tableStartMs = 0;
+bool g_solveAfterTables = false;
+bool g_tablesUnavailable[HeuristicKindCount] = {}; // a build failed, e.g. over --pdb-mem
+
+// IDA* solutions, kept across Reset/Scramble rounds and optionally on disk
+SolutionCache g_solutionCache(4096);
+std::string   g_solutionCacheFile;
+
 // UI state
 int g_winW = 800, g_winH = 600;
 int g_uiHeight = 180;
 int g_scrambleCount = 7;
+HeuristicKind g_heuristic = HeuristicCubie;
+int g_searchThreads = 1;
 enum UITab { TAB_MANUAL = 0, TAB_HEURISTIC = 1 };
 int g_activeTab = TAB_MANUAL;
 
@@ -49,11 +107,16 @@ std::vector<Button> g_buttons;
 
 void recomputeButtons();
 void startSolveAndPlay();
+void startSolveAndPlay(std::unique_ptr<Solver> solver);
+void startTableBuild();
+void cancelSolve();
+void resetCube();
+void requestFrames();
 
 // Handles animations for manual input (keyboard or buttons)
 void enqueueAnimatedMove(Face f, Turn t)
 {
-    if (g_solutionPlaying || g_currentMoveActive) return;
+    if (g_solutionPlaying || g_currentMoveActive || g_solveJob) return;
 
     g_solutionMoves.clear();
     g_solutionMoves.push_back(Move{f, t});
@@ -62,46 +125,13 @@ void enqueueAnimatedMove(Face f, Turn t)
     g_currentMoveActive = false;
     g_moveProgress = 0.0f;
     g_lastTimeMs = glutGet(GLUT_ELAPSED_TIME);
-}
-
-///// Text Helpers /////
-// individual moves
-std::string moveToString(const Move& m)
-{
-    char faceChar = ' ';
-    switch (m.face) {
-    case Front: faceChar = 'F'; break;
-    case Back:  faceChar = 'B'; break;
-    case Up:    faceChar = 'U'; break;
-    case Down:  faceChar = 'D'; break;
-    case Left:  faceChar = 'L'; break;
-    case Right: faceChar = 'R'; break;
-    default: break;
-    }
-    std::string s;
-    s += faceChar;
-    if (m.turn == CCW)          s += "'";
-    else if (m.turn == Double)  s += "2";
-    return s;
-}
-
-// handles a sequence of moves
-std::string movesToString(const std::vector<Move>& seq)
-{
-    std::string out;
-    bool first = true;
-    for (const Move& m : seq) {
-        if (!first) out += ' ';
-        out += moveToString(m);
-        first = false;
-    }
-    return out;
+    requestFrames();
 }
 
 // randomizes cube and creates log of moves
 void scramble(int moveCount)
 {
-    if (moveCount <= 0) return;
+    if (moveCount <= 0 || g_solveJob) return;
 
     static std::mt19937 rng(std::random_device{}());
     std::uniform_int_distribution<int> faceDist(0, Face::Count - 1);
@@ -133,6 +163,15 @@ void scramble(int moveCount)
     }
 }
 
+// back to solved, clearing the logs; not while a solve is running
+void resetCube()
+{
+    if (g_solveJob) return;
+    g_cube = RubiksCube();
+    g_scrambleHistory.clear(); g_scrambleText.clear(); g_solveText.clear();
+    g_solutionMoves.clear(); g_solutionPlaying = false; g_currentMoveActive = false;
+}
+
 // creates and handles menu buttons
 void recomputeButtons()
 {
@@ -183,12 +222,7 @@ void recomputeButtons()
             }
             if (r == 1) {
                 Button b; b.x0=cx; b.y0=y0; b.x1=cx+80; b.y1=y0+rowH; b.label="Reset";
-                b.onClick = [](){
-                    g_cube = RubiksCube();
-                    g_scrambleHistory.clear(); g_scrambleText.clear(); g_solveText.clear();
-                    g_solutionMoves.clear(); g_solutionPlaying = false; g_currentMoveActive = false;
-                    glutPostRedisplay();
-                };
+                b.onClick = [](){ resetCube(); glutPostRedisplay(); };
                 g_buttons.push_back(b);
             }
         }
@@ -207,13 +241,18 @@ void recomputeButtons()
         };
 
         addBtn(90, "Scramble", [](){ scramble(g_scrambleCount); glutPostRedisplay(); });
-        addBtn(70, "Reset", [](){
-             g_cube = RubiksCube();
-             g_scrambleHistory.clear(); g_scrambleText.clear(); g_solveText.clear();
-             g_solutionMoves.clear(); g_solutionPlaying = false; g_currentMoveActive = false;
-             glutPostRedisplay();
+        addBtn(70, "Reset", [](){ resetCube(); glutPostRedisplay(); });
+        if (g_solveJob || g_tableJob) {
+            addBtn(278, "Cancel", [](){ cancelSolve(); glutPostRedisplay(); });
+        } else {
+            addBtn(120, "Solve IDA*", [](){ startSolveAndPlay(); glutPostRedisplay(); });
+            addBtn(150, "Solve 2-Phase", [](){ startSolveAndPlay(std::make_unique<TwoPhaseSolver>()); glutPostRedisplay(); });
+        }
+        static const char* heuristicLabels[HeuristicKindCount] = { "H: Cubie", "H: Corners", "H: Corner+Edge" };
+        addBtn(150, heuristicLabels[g_heuristic], [](){
+            g_heuristic = static_cast<HeuristicKind>((g_heuristic + 1) % HeuristicKindCount);
+            startTableBuild(); recomputeButtons(); glutPostRedisplay();
         });
-        addBtn(120, "Solve IDA*", [](){ startSolveAndPlay(); glutPostRedisplay(); });
 
         addBtn(32, "-", [](){ if (g_scrambleCount>0) g_scrambleCount--; recomputeButtons(); glutPostRedisplay(); });
         x-=padX; x+=4;
@@ -256,7 +295,23 @@ void drawUI()
         drawText2D(textX, textY, "Scramble: " + g_scrambleText);
         textY -= 20;
     }
-    if (!g_solveText.empty()) {
+    if (g_solveJob) {
+        const SearchProgress& p = g_solveJob->progress();
+        char line[160];
+        std::snprintf(line, sizeof line, "%s: threshold %d, %.2fM nodes, %.1f s%s",
+                      g_solveJob->solver().name(), p.threshold.load(), p.nodes.load() / 1e6,
+                      (glutGet(GLUT_ELAPSED_TIME) - g_solveStartMs) * 0.001,
+                      g_solveJob->cancelled() ? "  (stopping)" : "  (c to cancel)");
+        drawText2D(textX, textY, std::string("Solving:  ") + line);
+    }
+    else if (g_tableJob) {
+        char line[160];
+        std::snprintf(line, sizeof line, "building pattern tables, %.1f s%s",
+                      (glutGet(GLUT_ELAPSED_TIME) - g_tableStartMs) * 0.001,
+                      g_tableJob->cancel.load() ? "  (stopping)" : "  (c to cancel)");
+        drawText2D(textX, textY, std::string("Solving:  ") + line);
+    }
+    else if (!g_solveText.empty()) {
         drawText2D(textX, textY, "Solve:    " + g_solveText);
     }
 
@@ -298,7 +353,9 @@ void motion(int x,int y)
 ///// Keyboard Controls /////
 void keyboard(unsigned char key,int x,int y)
 {
-    if ((g_solutionPlaying || g_currentMoveActive) && key != 27) return;
+    if (key == 'c') { cancelSolve(); recomputeButtons(); glutPostRedisplay(); return; }
+    if (key == 'h') { g_showHud = !g_showHud; requestFrames(); glutPostRedisplay(); return; }
+    if ((g_solutionPlaying || g_currentMoveActive || g_solveJob) && key != 27) return;
 
     switch(key){
     case 'f': enqueueAnimatedMove(Front, CW); break; case 'F': enqueueAnimatedMove(Front, CCW); break;
@@ -311,15 +368,18 @@ void keyboard(unsigned char key,int x,int y)
     case '3': enqueueAnimatedMove(Up,    Double); break; case '4': enqueueAnimatedMove(Down,  Double); break;
     case '5': enqueueAnimatedMove(Left,  Double); break; case '6': enqueueAnimatedMove(Right, Double); break;
     case 's': scramble(g_scrambleCount); break;
-    case '0':
-        g_cube = RubiksCube();
-        g_scrambleHistory.clear(); g_scrambleText.clear(); g_solveText.clear();
-        g_solutionMoves.clear(); g_solutionPlaying = false; g_currentMoveActive = false;
-        break;
+    case '0': resetCube(); break;
     case 'p': startSolveAndPlay(); break;
+    case 'k': startSolveAndPlay(std::make_unique<TwoPhaseSolver>()); break;
     case '+': case '=': g_camDist -= 0.3f; if(g_camDist<3.f) g_camDist=3.f; break;
     case '-': case '_': g_camDist += 0.3f; break;
-    case 27: exit(0); break;
+    case 27:
+        g_solveJob.reset();
+        g_tableJob.reset();
+        if (!g_solutionCacheFile.empty() && !g_solutionCache.save(g_solutionCacheFile))
+            std::cout << "Could not write " << g_solutionCacheFile << "\n";
+        exit(0);
+        break;
     }
     recomputeButtons(); glutPostRedisplay();
 }
@@ -361,27 +421,183 @@ void reshape(int w,int h)
     glutPostRedisplay();
 }
 
-// advances animations
-void idle()
+void playSolution(const std::vector<Move>& sol);
+
+// the IDA* solver behind a job, looking through the cache wrapper
+const IDAStarSolver* idaSolverOf(const Solver& solver)
+{
+    if (auto cached = dynamic_cast<const CachedSolver*>(&solver)) return idaSolverOf(cached->inner());
+    return dynamic_cast<const IDAStarSolver*>(&solver);
+}
+
+// collects a finished background solve, or cancels one past its budget
+void pollSolve()
+{
+    if (!g_solveJob) return;
+    if (!g_solveJob->ready()) {
+        bool overBudget = idaSolverOf(g_solveJob->solver()) &&
+                          glutGet(GLUT_ELAPSED_TIME) - g_solveStartMs > g_solveBudgetMs;
+        if (overBudget && !g_solveJob->cancelled()) g_solveJob->cancel();
+        return;
+    }
+
+    std::unique_ptr<AsyncSolve> job = std::move(g_solveJob);
+    std::vector<Move> sol = job->take();
+    const char* name = job->solver().name();
+    if (auto ida = idaSolverOf(job->solver())) {
+        if (ida->lastStats().outcome != SearchNotRun) std::cout << ida->lastStats().summary();
+        std::cout << g_solutionCache.summary() << "\n";
+    }
+    recomputeButtons();
+
+    if (!sol.empty()) {
+        std::cout << name << " solution length: " << sol.size() << "\n";
+        playSolution(sol);
+        return;
+    }
+    if (job->cube().isSolved()) return;
+
+    // nothing complete: show the closest the search got instead
+    const char* why = !job->cancelled() ? "no solution within limits" :
+                      g_solveCancelledByUser ? "cancelled" : "out of time";
+    std::vector<Move> partial;
+    int h = 0;
+    if (job->progress().partial(partial, h)) {
+        g_solveText = std::string(why) + ", best partial (" + std::to_string(h) + " from solved): " +
+                      (partial.empty() ? std::string("-") : movesToString(partial));
+    } else {
+        g_solveText = why;
+    }
+    std::cout << name << ": " << g_solveText << "\n";
+}
+
+void cancelSolve()
+{
+    if (g_tableJob) {
+        g_solveAfterTables = false;
+        g_tableJob->cancel.store(true);
+    }
+    if (!g_solveJob) return;
+    g_solveCancelledByUser = true;
+    g_solveJob->cancel();
+}
+
+// Whether the heuristic still needs tables loaded or built; not to be asked
+// while a build is running. Tables that failed to build are left to the
+// search, which falls back to the cubie bound without them.
+bool tablesPending(HeuristicKind kind)
+{
+    if (kind == HeuristicCubie || g_tablesUnavailable[kind]) return false;
+    if (!cornerPDB().isReady()) return true;
+    return kind == HeuristicCornersEdges && !(edgePDB(0).isReady() && edgePDB(1).isReady());
+}
+
+// loads or builds the tables the current heuristic needs in the background
+void startTableBuild()
+{
+    if (g_tableJob || !tablesPending(g_heuristic)) return;
+    g_tableJob = std::make_unique<TableBuild>();
+    g_tableStartMs = glutGet(GLUT_ELAPSED_TIME);
+    const std::atomic<bool>* cancel = &g_tableJob->cancel;
+    const HeuristicKind kind = g_tableJob->kind = g_heuristic;
+    g_tableJob->done = std::async(std::launch::async, [kind, cancel] {
+        bool ok = initCornerPDB(cancel);
+        if (kind == HeuristicCornersEdges) ok = initEdgePDBs(cancel) && ok;
+        return ok;
+    });
+    requestFrames();
+}
+
+// collects a finished table build; the heuristic may have moved on meanwhile
+void pollTables()
+{
+    if (!g_tableJob || g_tableJob->done.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+    const bool ok = g_tableJob->done.get();
+    const bool cancelled = g_tableJob->cancel.load();
+    const HeuristicKind kind = g_tableJob->kind;
+    g_tableJob.reset();
+
+    if (cancelled) {
+        g_solveText = "pattern tables cancelled, finished layers kept for next time";
+        g_solveAfterTables = false;
+    } else {
+        if (!ok) g_tablesUnavailable[kind] = true;
+        startTableBuild();
+        if (!g_tableJob && g_solveAfterTables) {
+            g_solveAfterTables = false;
+            startSolveAndPlay();
+        }
+    }
+    recomputeButtons();
+}
+
+bool animating() { return g_solutionPlaying || g_currentMoveActive || g_solveJob || g_tableJob; }
+
+// advances animations and background solves one frame, then books the next
+// one while there is still something to show; the HUD alone refreshes twice
+// a second so its CPU figure stays current without keeping the frame rate
+void frameTick(int)
 {
     int now = glutGet(GLUT_ELAPSED_TIME);
     float dt = (now - g_lastTimeMs) * 0.001f;
     g_lastTimeMs = now;
+    pollSolve();
+    pollTables();
     updateCurrentMove(dt);
     glutPostRedisplay();
+
+    const int frameMs = 1000 / std::max(1, g_targetFps);
+    const int periodMs = animating() ? frameMs : g_showHud ? 500 : 0;
+    if (periodMs == 0) { g_frameTimerRunning = false; return; }
+    // paced from when this frame was due, so timer slack does not add up;
+    // a late frame is not followed by a burst of catch-up frames
+    g_nextFrameMs += periodMs;
+    if (g_nextFrameMs <= now) g_nextFrameMs = now + 1;
+    glutTimerFunc(unsigned(g_nextFrameMs - now), frameTick, 0);
+}
+
+// starts the frame timer if it is not already running
+void requestFrames()
+{
+    if (g_frameTimerRunning) return;
+    g_frameTimerRunning = true;
+    g_lastTimeMs = g_nextFrameMs = glutGet(GLUT_ELAPSED_TIME);
+    glutTimerFunc(0, frameTick, 0);
 }
 
 void startSolveAndPlay()
 {
+    if (g_solveJob || g_solutionPlaying || g_currentMoveActive) return;
+    // the search would otherwise build missing tables itself, inside the solve
+    if (g_tableJob || tablesPending(g_heuristic)) {
+        g_solveAfterTables = true;
+        startTableBuild();
+        recomputeButtons();
+        return;
+    }
     int maxIterations  = g_scrambleCount;
     int iterationDepth = g_scrambleCount;
-    std::vector<Move> sol = g_cube.solveIDAStar(maxIterations, iterationDepth);
+    SearchOptions options;
+    options.heuristic = g_heuristic;
+    options.threads = g_searchThreads;
+    startSolveAndPlay(std::make_unique<CachedSolver>(
+        std::make_unique<IDAStarSolver>(maxIterations, iterationDepth, options), g_solutionCache));
+}
 
-    if (sol.empty()) {
-        std::cout << "IDA* found no solution within limits.\n";
-        return;
-    }
-    std::cout << "IDA* solution length: " << sol.size() << "\n";
+// hands the solve to a worker thread; frameTick() picks up the result
+void startSolveAndPlay(std::unique_ptr<Solver> solver)
+{
+    if (g_solveJob || g_solutionPlaying || g_currentMoveActive) return;
+    g_solveText.clear();
+    g_solveCancelledByUser = false;
+    g_solveStartMs = glutGet(GLUT_ELAPSED_TIME);
+    g_solveJob = std::make_unique<AsyncSolve>(std::move(solver), g_cube);
+    recomputeButtons();
+    requestFrames();
+}
+
+void playSolution(const std::vector<Move>& sol)
+{
     g_solutionMoves = sol;
     g_solutionIndex = 0;
     g_solutionPlaying = true;
@@ -389,10 +605,41 @@ void startSolveAndPlay()
     g_moveProgress = 0.0f;
     g_lastTimeMs = glutGet(GLUT_ELAPSED_TIME);
     g_solveText = movesToString(sol);
+    requestFrames();
+}
+
+// frame timings and CPU use in the top left of the cube view
+void drawHud(int viewH)
+{
+    FrameStats& st = g_frameStats;
+    auto now = std::chrono::steady_clock::now();
+    double wallMs = std::chrono::duration<double, std::milli>(now - st.sampleWall).count();
+    if (st.frames == 0 || wallMs >= 500.0) {
+        std::clock_t cpu = std::clock();
+        if (st.frames > 0) st.cpuPercent = 100.0 * double(cpu - st.sampleCpu) / CLOCKS_PER_SEC / (wallMs * 0.001);
+        st.sampleCpu = cpu;
+        st.sampleWall = now;
+    }
+
+    glMatrixMode(GL_PROJECTION); glPushMatrix(); glLoadIdentity();
+    glOrtho(0, g_winW, 0, viewH, -1, 1);
+    glMatrixMode(GL_MODELVIEW); glPushMatrix(); glLoadIdentity();
+    glDisable(GL_DEPTH_TEST);
+
+    char line[160];
+    std::snprintf(line, sizeof line, "draw %.2f ms  frame %.1f ms  CPU %.0f%%  target %d fps  %s",
+                  st.drawMs, st.intervalMs, st.cpuPercent, g_targetFps,
+                  g_frameTimerRunning && animating() ? "animating" : "idle");
+    glColor3f(0.9f, 0.9f, 0.9f);
+    drawText2D(8, viewH - 22, line);
+
+    glEnable(GL_DEPTH_TEST);
+    glPopMatrix(); glMatrixMode(GL_PROJECTION); glPopMatrix(); glMatrixMode(GL_MODELVIEW);
 }
 
 void display()
 {
+    auto frameStart = std::chrono::steady_clock::now();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     int viewH = (g_winH > g_uiHeight) ? (g_winH - g_uiHeight) : 1;
     glViewport(0, g_uiHeight, g_winW, viewH);
@@ -405,17 +652,57 @@ void display()
     glRotatef(g_camAngleX, 1,0,0);
     glRotatef(g_camAngleY, 0,1,0);
 
-    drawCube3D(g_cube, g_currentMoveActive, g_currentMove, g_moveProgress, g_moveDuration);
+    g_cubeRenderer.draw(g_cube, g_currentMoveActive, g_currentMove, g_moveProgress, g_moveDuration);
+    if (g_showHud) drawHud(viewH);
 
     glViewport(0,0,g_winW,g_uiHeight);
     drawUI();
 
     glutSwapBuffers();
+
+    // smoothed over roughly the last ten frames
+    FrameStats& st = g_frameStats;
+    auto frameEnd = std::chrono::steady_clock::now();
+    double drawMs = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+    double intervalMs = st.frames > 0 ? std::chrono::duration<double, std::milli>(frameStart - st.lastFrame).count() : 0.0;
+    st.drawMs = st.frames > 0 ? st.drawMs * 0.9 + drawMs * 0.1 : drawMs;
+    st.intervalMs = st.frames > 1 ? st.intervalMs * 0.9 + intervalMs * 0.1 : intervalMs;
+    st.lastFrame = frameStart;
+    ++st.frames;
 }
 
 int main(int argc,char** argv)
 {
+    initCoordTables();
+    std::cout << "Coordinate move tables built in " << coordTableBuildMs() << " ms\n";
+    initTwoPhaseTables();
+
     glutInit(&argc,argv);
+
+    // options left over after GLUT took its own
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--hud") { g_showHud = true; continue; }
+        if (i + 1 >= argc) break;
+        try {
+            if (arg == "--pdb-mem") {
+                const long long mb = std::stoll(argv[++i]);
+                if (mb < 0 || uint64_t(mb) > (SIZE_MAX >> 20)) throw std::out_of_range(argv[i]);
+                pdbOptions().memoryBudget = size_t(mb) << 20;
+            }
+            else if (arg == "--pdb-dir") pdbOptions().directory = argv[++i];
+            else if (arg == "--threads") pdbOptions().threads = g_searchThreads = std::stoi(argv[++i]);
+            else if (arg == "--solve-ms") g_solveBudgetMs = std::stoi(argv[++i]);
+            else if (arg == "--cache-file") g_solutionCacheFile = argv[++i];
+            else if (arg == "--fps") g_targetFps = std::max(1, std::stoi(argv[++i]));
+        } catch (const std::logic_error&) {
+            std::cerr << "bad value for " << arg << ": " << argv[i] << "\n";
+            return 2;
+        }
+    }
+    if (!g_solutionCacheFile.empty() && g_solutionCache.load(g_solutionCacheFile)) {
+        std::cout << "Loaded " << g_solutionCache.size() << " cached solutions from " << g_solutionCacheFile << "\n";
+    }
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_DEPTH);
     glutInitWindowSize(g_winW,g_winH);
     glutCreateWindow("Rubik's Cube - Interactive Visualizer");
@@ -429,9 +716,9 @@ int main(int argc,char** argv)
     glutMotionFunc(motion);
     glutKeyboardFunc(keyboard);
     glutSpecialFunc(specialKeys);
-    glutIdleFunc(idle);
 
     recomputeButtons();
+    if (g_showHud) requestFrames();
     glutMainLoop();
     return 0;
 }
\ No newline at end of file
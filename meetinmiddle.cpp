@@ -0,0 +1,237 @@
+#include "idastar.hpp"
+#include "pdb.hpp"
+#include "solver.hpp"
+#include <chrono>
+#include <map>
+
+// ----- Frontier Table -----
+
+// states within d moves of solved, d = 0..7
+static const long long kStatesWithin[] = { 1, 19, 262, 3502, 46741, 621649, 8240087, 109043123 };
+static constexpr int MAX_FRONTIER_DEPTH = 7;
+
+// Every state within depth() moves of solved, in open-addressed 64-bit
+// slots. A slot holds the upper bits of the state's hash and a move code:
+// the move (plus one) that takes the state one step nearer solved, the
+// inverse of the move the BFS reached it by. Two states with the same hash
+// bits would be confused, so joined paths are checked before use; a
+// collision only costs a missed meet.
+class MeetFrontier
+{
+public:
+    static constexpr int HOME = 31; // code of the solved state itself
+
+    explicit MeetFrontier(int depth)
+        : depth_(depth)
+    {
+        slots_.assign(slotsFor(depth), 0);
+        mask_ = slots_.size() - 1;
+
+        CoordCube solved;
+        insert(hashOf(solved), HOME);
+        vector<CoordCube> layer{ solved }, next;
+        for (int d = 1; d <= depth; ++d)
+        {
+            next.clear();
+            for (const CoordCube& c : layer)
+                for (int m = 0; m < MOVE_COUNT; ++m)
+                {
+                    CoordCube n = c;
+                    n.applyMove(m);
+                    const int back = moveIndex(inverseOf(allMoves[m]));
+                    if (insert(hashOf(n), back + 1) && d < depth) next.push_back(n);
+                }
+            layer.swap(next);
+        }
+    }
+
+    int depth() const { return depth_; }
+    long long states() const { return states_; }
+
+    // the state's move code, or -1 when it is more than depth() from solved
+    int find(const CoordCube& c) const
+    {
+        const uint64_t hash = hashOf(c);
+        for (size_t i = hash & mask_; slots_[i] != 0; i = (i + 1) & mask_)
+            if ((slots_[i] & ~CODE_MASK) == (hash & ~CODE_MASK)) return int(slots_[i] & CODE_MASK);
+        return -1;
+    }
+
+    // slots at most three quarters full, a power of two for masking
+    static size_t slotsFor(int depth)
+    {
+        size_t slots = 1;
+        while (slots * 3 < size_t(kStatesWithin[depth]) * 4) slots *= 2;
+        return slots;
+    }
+
+    // the table plus the BFS layer kept while the last one is hashed
+    static size_t bytesFor(int depth)
+    {
+        const long long lastLayer = depth > 0 ? kStatesWithin[depth - 1] - (depth > 1 ? kStatesWithin[depth - 2] : 0) : 1;
+        return slotsFor(depth) * sizeof(uint64_t) + size_t(lastLayer) * sizeof(CoordCube);
+    }
+
+private:
+    static constexpr uint64_t CODE_MASK = 31;
+
+    static uint64_t hashOf(const CoordCube& c) { return stateKey(c, 0); }
+
+    // false when the state is already in the table
+    bool insert(uint64_t hash, int code)
+    {
+        size_t i = hash & mask_;
+        for (; slots_[i] != 0; i = (i + 1) & mask_)
+            if ((slots_[i] & ~CODE_MASK) == (hash & ~CODE_MASK)) return false;
+        slots_[i] = (hash & ~CODE_MASK) | uint64_t(code);
+        ++states_;
+        return true;
+    }
+
+    vector<uint64_t> slots_;
+    size_t mask_ = 0;
+    int depth_;
+    long long states_ = 0;
+};
+
+int meetInMiddleDepth(size_t frontierBytes)
+{
+    int depth = 1;
+    while (depth < MAX_FRONTIER_DEPTH && MeetFrontier::bytesFor(depth + 1) <= frontierBytes) ++depth;
+    return depth;
+}
+
+// one table per depth, built on first use and shared by every solver
+static const MeetFrontier& frontierFor(size_t frontierBytes)
+{
+    static std::mutex lock;
+    static std::map<int, std::unique_ptr<MeetFrontier>> tables;
+
+    const int depth = meetInMiddleDepth(frontierBytes);
+    std::lock_guard<std::mutex> guard(lock);
+    std::unique_ptr<MeetFrontier>& table = tables[depth];
+    if (!table)
+    {
+        initCoordTables();
+        auto t0 = std::chrono::steady_clock::now();
+        table = std::make_unique<MeetFrontier>(depth);
+        std::clog << "Meet-in-the-middle frontier: " << table->states() << " states within " << depth
+                  << " moves, " << (MeetFrontier::slotsFor(depth) * sizeof(uint64_t) >> 20) << " MB, built in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count()
+                  << " ms\n";
+    }
+    return *table;
+}
+
+void initMeetInMiddle(size_t frontierBytes)
+{
+    frontierFor(frontierBytes);
+}
+
+// ----- Forward Search -----
+
+struct MeetSearch
+{
+    const MeetFrontier* frontier = nullptr;
+    CoordCube start;
+    const PatternDatabase* corners = nullptr; // sharpens the cubie bound when loaded
+    SearchProgress* progress = nullptr;
+
+    uint8_t path[MAX_SEARCH_DEPTH];
+    int length = 0;        // total solution length this pass looks for
+    int forwardDepth = 0;  // where the frontier takes over
+    bool stopped = false;
+    long long nodes = 0, probes = 0;
+    vector<Move> solution;
+
+    // forward path then the frontier's moves home; checked against the
+    // start so a hash collision cannot return a wrong answer
+    bool join(const CoordCube& meet, int forward)
+    {
+        ++probes;
+        int code = frontier->find(meet);
+        if (code < 0) return false;
+
+        vector<Move> moves;
+        for (int i = 0; i < forward; ++i) moves.push_back(allMoves[path[i]]);
+        CoordCube cur = meet;
+        for (int steps = 0; code != MeetFrontier::HOME; ++steps)
+        {
+            if (code < 1 || code > MOVE_COUNT || steps >= frontier->depth()) return false;
+            moves.push_back(allMoves[code - 1]);
+            cur.applyMove(code - 1);
+            code = frontier->find(cur);
+        }
+
+        CoordCube check = start;
+        for (const Move& m : moves) check.applyMove(moveIndex(m));
+        if (!check.isSolved()) return false;
+        solution = std::move(moves);
+        return true;
+    }
+
+    int heuristic(const CoordCube& c) const
+    {
+        int h = c.heuristic();
+        if (corners) h = std::max(h, corners->get(cornerIndex(c)));
+        return h;
+    }
+
+    bool dfs(const CoordCube& c, int g, int lastFace)
+    {
+        if ((++nodes & 4095) == 0 && progress)
+        {
+            progress->nodes.fetch_add(4096, std::memory_order_relaxed);
+            if (progress->cancel.load(std::memory_order_relaxed)) stopped = true;
+        }
+        if (stopped) return false;
+        if (g + heuristic(c) > length) return false; // also spares probes that cannot hit
+        if (g == forwardDepth) return join(c, g);
+
+        const MoveSuccessors& next = kMoveSuccessors[lastFace];
+        for (int i = 0; i < next.count; ++i)
+        {
+            const int m = next.moves[i];
+            CoordCube child = c;
+            child.applyMove(m);
+            path[g] = uint8_t(m);
+            if (dfs(child, g + 1, m / 3)) return true;
+        }
+        return false;
+    }
+};
+
+vector<Move> MeetInMiddleSolver::solve(const RubiksCube& cube)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point t0 = Clock::now();
+    stats_ = Stats();
+    if (cube.isSolved()) return {};
+
+    initCoordTables();
+    const MeetFrontier& frontier = frontierFor(frontierBytes_);
+    stats_.frontierDepth = frontier.depth();
+    stats_.frontierStates = frontier.states();
+
+    MeetSearch s;
+    s.frontier = &frontier;
+    s.start = CoordCube(CubieCube(cube));
+    s.progress = progress_;
+    if (heuristic_ != HeuristicCubie && initCornerPDB()) s.corners = &cornerPDB();
+
+    // within the frontier the BFS distances are exact, so this is optimal;
+    // past it every total length is tried in turn, shortest first
+    bool found = s.join(s.start, 0);
+    for (int length = frontier.depth() + 1; !found && !s.stopped && length <= maxLength_; ++length)
+    {
+        if (progress_) progress_->threshold.store(length, std::memory_order_relaxed);
+        s.length = length;
+        s.forwardDepth = std::min(length - frontier.depth(), MAX_SEARCH_DEPTH);
+        found = s.dfs(s.start, 0, Face::Count);
+    }
+
+    stats_.forwardNodes = s.nodes;
+    stats_.probes = s.probes;
+    stats_.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return found ? s.solution : vector<Move>();
+}
@@ -0,0 +1,162 @@
+#include "nxncube.hpp"
+
+///// Text Helpers /////
+// individual moves
+std::string moveToString(const Move& m)
+{
+    char faceChar = ' ';
+    switch (m.face) {
+    case Front: faceChar = 'F'; break;
+    case Back:  faceChar = 'B'; break;
+    case Up:    faceChar = 'U'; break;
+    case Down:  faceChar = 'D'; break;
+    case Left:  faceChar = 'L'; break;
+    case Right: faceChar = 'R'; break;
+    default: break;
+    }
+    std::string s;
+    s += faceChar;
+    if (m.turn == CCW)          s += "'";
+    else if (m.turn == Double)  s += "2";
+    return s;
+}
+
+// handles a sequence of moves
+std::string movesToString(const std::vector<Move>& seq)
+{
+    std::string out;
+    appendMoves(out, seq);
+    return out;
+}
+
+// appends to out without temporaries, so a reused buffer only grows
+void appendMoves(std::string& out, const std::vector<Move>& seq)
+{
+    static const char kFaceChars[] = { 'U', 'D', 'L', 'R', 'F', 'B' };
+    bool first = true;
+    for (const Move& m : seq) {
+        if (!first) out += ' ';
+        out += kFaceChars[m.face];
+        if (m.turn == CCW)          out += '\'';
+        else if (m.turn == Double)  out += '2';
+        first = false;
+    }
+}
+
+// parses a whitespace separated sequence in the same notation
+bool parseMoves(const std::string& text, vector<Move>& out)
+{
+    out.clear();
+    size_t i = 0, n = text.size();
+    while (i < n)
+    {
+        char c = text[i];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') { ++i; continue; }
+
+        Move m{Face::Count, CW};
+        switch (c) {
+        case 'F': m.face = Front; break;
+        case 'B': m.face = Back;  break;
+        case 'U': m.face = Up;    break;
+        case 'D': m.face = Down;  break;
+        case 'L': m.face = Left;  break;
+        case 'R': m.face = Right; break;
+        default: return false;
+        }
+        ++i;
+        if (i < n && text[i] == '2')       { m.turn = Double; ++i; if (i < n && text[i] == '\'') ++i; }
+        else if (i < n && text[i] == '\'') { m.turn = CCW; ++i; }
+
+        // a move must end at whitespace or the end of the text
+        if (i < n && text[i] != ' ' && text[i] != '\t' && text[i] != '\r' && text[i] != '\n') return false;
+        out.push_back(m);
+    }
+    return true;
+}
+
+///// Layer Moves /////
+
+// appends one layer move; a run of inner layers that WCA cannot name is
+// written as one slice turn per layer
+static void appendLayerMove(std::string& out, const LayerMove& m)
+{
+    static const char kFaceChars[] = { 'U', 'D', 'L', 'R', 'F', 'B' };
+    auto suffix = [&] {
+        if (m.turn == CCW)          out += '\'';
+        else if (m.turn == Double)  out += '2';
+    };
+    if (m.first > 0 && m.last > m.first) {
+        for (int d = m.first; d <= m.last; ++d) {
+            if (d > m.first) out += ' ';
+            appendLayerMove(out, LayerMove{m.face, uint8_t(d), uint8_t(d), m.turn});
+        }
+        return;
+    }
+    if (m.first > 0)     out += std::to_string(m.first + 1);   // 2R
+    else if (m.last > 1) out += std::to_string(m.last + 1);    // 3Rw
+    out += kFaceChars[m.face];
+    if (m.first == 0 && m.last > 0) out += 'w';
+    suffix();
+}
+
+std::string layerMovesToString(const vector<LayerMove>& seq)
+{
+    std::string out;
+    appendLayerMoves(out, seq);
+    return out;
+}
+
+void appendLayerMoves(std::string& out, const vector<LayerMove>& seq)
+{
+    bool first = true;
+    for (const LayerMove& m : seq) {
+        if (!first) out += ' ';
+        appendLayerMove(out, m);
+        first = false;
+    }
+}
+
+bool parseLayerMoves(const std::string& text, int n, vector<LayerMove>& out)
+{
+    out.clear();
+    size_t i = 0, len = text.size();
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+    while (i < len)
+    {
+        if (isSpace(text[i])) { ++i; continue; }
+
+        // optional layer count, then the face letter, lowercase for two layers wide
+        int count = 0;
+        while (i < len && text[i] >= '0' && text[i] <= '9') { count = count * 10 + (text[i] - '0'); ++i; if (count > 99) return false; }
+        if (i >= len) return false;
+
+        LayerMove m;
+        bool wide = false;
+        char c = text[i];
+        if (c >= 'a' && c <= 'z') { wide = true; c = char(c - 'a' + 'A'); }
+        switch (c) {
+        case 'F': m.face = Front; break;
+        case 'B': m.face = Back;  break;
+        case 'U': m.face = Up;    break;
+        case 'D': m.face = Down;  break;
+        case 'L': m.face = Left;  break;
+        case 'R': m.face = Right; break;
+        default: return false;
+        }
+        ++i;
+        if (i < len && text[i] == 'w') { if (wide) return false; wide = true; ++i; }
+
+        const int last = wide ? (count > 0 ? count : 2) - 1 : (count > 0 ? count - 1 : 0);
+        if (last >= n) return false;
+        m.first = uint8_t(wide ? 0 : last);
+        m.last  = uint8_t(last);
+
+        if (i < len && text[i] == '2')       { m.turn = Double; ++i; if (i < len && text[i] == '\'') ++i; }
+        else if (i < len && text[i] == '\'') { m.turn = CCW; ++i; }
+
+        // a move must end at whitespace or the end of the text
+        if (i < len && !isSpace(text[i])) return false;
+        out.push_back(m);
+    }
+    return true;
+}
@@ -0,0 +1,235 @@
+#ifndef NXNCUBE_HPP
+#define NXNCUBE_HPP
+
+#include "stickermoves.hpp"
+#include <type_traits>
+
+///// LAYER MOVES /////
+
+// A turn of layers first..last counted in from face (0 is the face itself),
+// all turned together as seen from that face. R is {Right,0,0}, Rw or r
+// {Right,0,1}, 3Rw {Right,0,2} and the inner slice 2R {Right,1,1}.
+struct LayerMove
+{
+    Face    face  = Up;
+    uint8_t first = 0;
+    uint8_t last  = 0;
+    Turn    turn  = CW;
+
+    bool operator==(const LayerMove& o) const
+    {
+        return face == o.face && first == o.first && last == o.last && turn == o.turn;
+    }
+};
+
+inline constexpr LayerMove inverseOf(const LayerMove& m)
+{
+    LayerMove tmp = m;
+    if (tmp.turn == CW)       tmp.turn = CCW;
+    else if (tmp.turn == CCW) tmp.turn = CW;
+    return tmp;
+}
+
+inline LayerMove outerLayer(const Move& m) { return LayerMove{m.face, 0, 0, m.turn}; }
+
+// WCA notation (R, Rw, 3Rw, R2, Rw') plus SiGN inner slices (2R) and
+// lowercase wide turns (r); false on the first token that is not a move
+// of an n x n cube
+bool parseLayerMoves(const std::string& text, int n, vector<LayerMove>& out);
+std::string layerMovesToString(const vector<LayerMove>& seq);
+void appendLayerMoves(std::string& out, const vector<LayerMove>& seq);
+
+///// NxN GEOMETRY /////
+
+// Stickers are stored face by face, each face row-major, as on the 3x3.
+// Every face turn of every layer is generated here at compile time from
+// the cube's geometry as a set of sticker 4-cycles: a layer turn moves N
+// stickers around each of the four sides and, for the outer layers, the
+// face's own N x N stickers, so the apply loops have fixed trip counts.
+namespace nxngeo
+{
+    // position of a sticker: the cubie's grid cell and the face it points out of
+    struct Place { int x, y, z; Face face; };
+
+    template <int N>
+    constexpr Place placeOf(int sticker)
+    {
+        const Face f = Face(sticker / (N * N));
+        const int row = sticker % (N * N) / N, col = sticker % N;
+        switch (f) {
+        case Up:    return { col, N - 1, row, f };
+        case Down:  return { col, 0, N - 1 - row, f };
+        case Left:  return { 0, N - 1 - row, col, f };
+        case Right: return { N - 1, N - 1 - row, N - 1 - col, f };
+        case Front: return { col, N - 1 - row, N - 1, f };
+        default:    return { N - 1 - col, N - 1 - row, 0, f };
+        }
+    }
+
+    template <int N>
+    constexpr int stickerOf(const Place& p)
+    {
+        int row = 0, col = 0;
+        switch (p.face) {
+        case Up:    row = p.z;         col = p.x;         break;
+        case Down:  row = N - 1 - p.z; col = p.x;         break;
+        case Left:  row = N - 1 - p.y; col = p.z;         break;
+        case Right: row = N - 1 - p.y; col = N - 1 - p.z; break;
+        case Front: row = N - 1 - p.y; col = p.x;         break;
+        default:    row = N - 1 - p.y; col = N - 1 - p.x; break;
+        }
+        return p.face * N * N + row * N + col;
+    }
+
+    // cell coordinate along the face's axis of layer d counted in from it
+    template <int N>
+    constexpr bool inLayer(const Place& p, Face f, int d)
+    {
+        switch (f) {
+        case Up:    return p.y == N - 1 - d;
+        case Down:  return p.y == d;
+        case Left:  return p.x == d;
+        case Right: return p.x == N - 1 - d;
+        case Front: return p.z == N - 1 - d;
+        default:    return p.z == d;
+        }
+    }
+
+    // a quarter turn clockwise as seen from outside face f, in coordinates
+    // doubled and centred so the rotation stays on integers
+    template <int N>
+    constexpr Place turnCW(const Place& p, Face f)
+    {
+        int X = 2 * p.x - (N - 1), Y = 2 * p.y - (N - 1), Z = 2 * p.z - (N - 1);
+        int nx = p.face == Right ? 1 : p.face == Left ? -1 : 0;
+        int ny = p.face == Up ? 1 : p.face == Down ? -1 : 0;
+        int nz = p.face == Front ? 1 : p.face == Back ? -1 : 0;
+        auto spin = [f](int& a, int& b, int& c) {
+            // -90 degrees about the face's outward axis
+            int x = a, y = b, z = c;
+            switch (f) {
+            case Up:    a = -z; c = x;  break;
+            case Down:  a = z;  c = -x; break;
+            case Right: b = z;  c = -y; break;
+            case Left:  b = -z; c = y;  break;
+            case Front: a = y;  b = -x; break;
+            default:    a = -y; b = x;  break;
+            }
+        };
+        spin(X, Y, Z);
+        spin(nx, ny, nz);
+        const Face face = nx > 0 ? Right : nx < 0 ? Left : ny > 0 ? Up : ny < 0 ? Down : nz > 0 ? Front : Back;
+        return { (X + (N - 1)) / 2, (Y + (N - 1)) / 2, (Z + (N - 1)) / 2, face };
+    }
+
+    template <int N>
+    struct LayerCycles
+    {
+        static constexpr int MAX = N + N * N / 4;
+        int count = 0;
+        // a clockwise turn carries the sticker at cycle[i] to cycle[i + 1]
+        array<array<uint16_t, 4>, MAX> cycle{};
+    };
+
+    template <int N>
+    constexpr LayerCycles<N> makeLayerCycles(Face f, int d)
+    {
+        constexpr int STICKERS = 6 * N * N;
+        LayerCycles<N> out;
+        array<int, STICKERS> to{};
+        array<bool, STICKERS> seen{};
+        for (int s = 0; s < STICKERS; ++s)
+        {
+            const Place p = placeOf<N>(s);
+            to[s] = inLayer<N>(p, f, d) ? stickerOf<N>(turnCW<N>(p, f)) : s;
+        }
+        for (int s = 0; s < STICKERS; ++s)
+        {
+            if (seen[s] || to[s] == s) continue;
+            array<uint16_t, 4>& c = out.cycle[out.count++];
+            int at = s;
+            for (int i = 0; i < 4; ++i) { c[i] = uint16_t(at); seen[at] = true; at = to[at]; }
+        }
+        return out;
+    }
+
+    // indexed face * N + layer
+    template <int N>
+    constexpr array<LayerCycles<N>, 6 * N> makeAllLayerCycles()
+    {
+        array<LayerCycles<N>, 6 * N> all{};
+        for (int f = 0; f < Face::Count; ++f)
+            for (int d = 0; d < N; ++d) all[f * N + d] = makeLayerCycles<N>(Face(f), d);
+        return all;
+    }
+
+    template <int N>
+    inline constexpr array<LayerCycles<N>, 6 * N> kLayerCycles = makeAllLayerCycles<N>();
+}
+
+///// NxN CUBE /////
+
+// An N x N x N cube for N = 2..7 that tracks which solved sticker sits in
+// every place, so pieces that look alike stay apart. The 3x3 solvers keep
+// using RubiksCube and its byte shuffles; this type is for other sizes and
+// for checking that both agree.
+template <int N>
+class NxNCube
+{
+public:
+    static_assert(N >= 2 && N <= 7, "NxNCube covers 2x2 through 7x7");
+
+    static constexpr int SIZE = N;
+    static constexpr int STICKERS = 6 * N * N;
+    using StickerId = std::conditional_t<(STICKERS <= 256), uint8_t, uint16_t>;
+
+    NxNCube() { for (int i = 0; i < STICKERS; ++i) ids_[i] = StickerId(i); }
+
+    // the solved sticker now at place i, and the colour that shows there
+    int id(int i) const { return ids_[i]; }
+    static Color colorOf(int id) { return Color(kSolvedStickers[stickerIndex(Face(id / (N * N)), 1, 1)]); }
+    Color sticker(Face f, int row, int col) const { return colorOf(ids_[f * N * N + row * N + col]); }
+    SideN<N> face(Face f) const
+    {
+        SideN<N> s;
+        for (int r = 0; r < N; ++r)
+            for (int c = 0; c < N; ++c) s.squares[r][c] = sticker(f, r, c);
+        return s;
+    }
+
+    void applyLayer(Face f, int layer, Turn t)
+    {
+        const nxngeo::LayerCycles<N>& lc = nxngeo::kLayerCycles<N>[f * N + layer];
+        for (int i = 0; i < lc.count; ++i)
+        {
+            const array<uint16_t, 4>& c = lc.cycle[i];
+            StickerId a = ids_[c[0]], b = ids_[c[1]], d = ids_[c[2]], e = ids_[c[3]];
+            switch (t) {
+            case CW:     ids_[c[1]] = a; ids_[c[2]] = b; ids_[c[3]] = d; ids_[c[0]] = e; break;
+            case CCW:    ids_[c[3]] = a; ids_[c[0]] = b; ids_[c[1]] = d; ids_[c[2]] = e; break;
+            case Double: ids_[c[2]] = a; ids_[c[3]] = b; ids_[c[0]] = d; ids_[c[1]] = e; break;
+            }
+        }
+    }
+    void applyMove(const LayerMove& m)
+    {
+        for (int d = m.first; d <= m.last; ++d) applyLayer(m.face, d, m.turn);
+    }
+    void applyMoves(const vector<LayerMove>& seq) { for (const LayerMove& m : seq) applyMove(m); }
+
+    // every face one colour, which on even sizes may be any whole-cube turn
+    // of the solved cube; centres of one colour may sit in any order
+    bool isSolved() const
+    {
+        for (int i = 0; i < STICKERS; ++i)
+            if (ids_[i] / (N * N) != ids_[i - i % (N * N)] / (N * N)) return false;
+        return true;
+    }
+
+    bool operator==(const NxNCube& o) const { return ids_ == o.ids_; }
+
+private:
+    array<StickerId, STICKERS> ids_;
+};
+
+#endif // NXNCUBE_HPP
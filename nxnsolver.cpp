@@ -0,0 +1,512 @@
+#include "nxnsolver.hpp"
+#include "cubie.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <ostream>
+
+// ----- Commutator Tables -----
+
+namespace
+{
+    // Wings or centres that only ever trade places among themselves. For a
+    // wing orbit places holds one sticker per wing, chosen so every move
+    // carries it onto another place of the list: wings cannot flip in
+    // their slot, so that sticker identifies the wing and where it goes.
+    struct Orbit
+    {
+        bool centers = false;
+        vector<int> places;              // sticker positions
+        int parityMove = -1;             // inner quarter turn that is a 4-cycle here (wings)
+        // sequences by (a, b, c) index triple, moving the piece at a to b,
+        // b to c and c to a; empty where no commutator was found
+        vector<vector<uint8_t>> cycles;
+
+        int index(int a, int b, int c) const
+        {
+            const int n = int(places.size());
+            return (a * n + b) * n + c;
+        }
+    };
+
+    struct ReductionTables
+    {
+        vector<LayerMove> moves; // every single-layer turn from the outer layer to the middle
+        vector<Orbit> orbits;
+    };
+
+    // where each sticker goes under m
+    template <int N>
+    vector<int> destinations(const vector<LayerMove>& seq)
+    {
+        NxNCube<N> c;
+        c.applyMoves(seq);
+        vector<int> to(NxNCube<N>::STICKERS);
+        for (int q = 0; q < NxNCube<N>::STICKERS; ++q) to[c.id(q)] = q;
+        return to;
+    }
+
+    template <int N>
+    ReductionTables buildTables()
+    {
+        constexpr int STICKERS = NxNCube<N>::STICKERS;
+        ReductionTables t;
+        for (int f = 0; f < Face::Count; ++f)
+            for (int d = 0; d <= (N - 1) / 2; ++d)
+                for (int turn = 0; turn < 3; ++turn)
+                    t.moves.push_back(LayerMove{Face(f), uint8_t(d), uint8_t(d), Turn(turn)});
+        const int moveCount = int(t.moves.size());
+
+        vector<vector<int>> moveTo(moveCount);
+        for (int m = 0; m < moveCount; ++m) moveTo[m] = destinations<N>({t.moves[m]});
+
+        // sticker orbits under all turns
+        vector<int> parent(STICKERS);
+        for (int s = 0; s < STICKERS; ++s) parent[s] = s;
+        auto root = [&](int s) { while (parent[s] != s) s = parent[s] = parent[parent[s]]; return s; };
+        for (const vector<int>& to : moveTo)
+            for (int s = 0; s < STICKERS; ++s) parent[root(s)] = root(to[s]);
+
+        // cubie cell of every sticker and how many stickers that cubie has
+        vector<int> cell(STICKERS), cellStickers(N * N * N, 0);
+        for (int s = 0; s < STICKERS; ++s)
+        {
+            nxngeo::Place p = nxngeo::placeOf<N>(s);
+            cell[s] = (p.x * N + p.y) * N + p.z;
+            ++cellStickers[cell[s]];
+        }
+
+        // keep orbits of one sticker per wing or centre cubie, one orbit per set
+        // of cubies; corners, middle edges and fixed centres are the skeleton's
+        vector<int> orbitOf(STICKERS, -1);
+        vector<vector<int>> seenCells;
+        for (int s = 0; s < STICKERS; ++s)
+        {
+            if (root(s) != s) continue;
+            vector<int> places, cells;
+            bool eligible = true;
+            for (int q = 0; q < STICKERS; ++q)
+            {
+                if (root(q) != s) continue;
+                if (cellStickers[cell[q]] > 2 || std::find(cells.begin(), cells.end(), cell[q]) != cells.end())
+                    eligible = false;
+                places.push_back(q);
+                cells.push_back(cell[q]);
+            }
+            if (!eligible || places.size() <= 6) continue;
+            std::sort(cells.begin(), cells.end());
+            if (std::find(seenCells.begin(), seenCells.end(), cells) != seenCells.end()) continue;
+            seenCells.push_back(cells);
+
+            Orbit o;
+            o.centers = cellStickers[cell[s]] == 1;
+            o.places = places;
+            o.cycles.resize(places.size() * places.size() * places.size());
+            t.orbits.push_back(std::move(o));
+        }
+
+        // wings first: their parity turns move centres
+        std::stable_partition(t.orbits.begin(), t.orbits.end(), [](const Orbit& o) { return !o.centers; });
+        for (size_t k = 0; k < t.orbits.size(); ++k)
+            for (int p : t.orbits[k].places) orbitOf[p] = int(k);
+
+        vector<int> indexIn(STICKERS, -1);
+        for (const Orbit& o : t.orbits)
+            for (size_t i = 0; i < o.places.size(); ++i) indexIn[o.places[i]] = int(i);
+
+        for (Orbit& o : t.orbits)
+        {
+            if (o.centers) continue;
+            for (int m = 0; m < moveCount && o.parityMove < 0; ++m)
+            {
+                const LayerMove& lm = t.moves[m];
+                if (lm.turn != CW || lm.first == 0 || 2 * lm.first == N - 1) continue;
+                for (int p : o.places)
+                    if (moveTo[m][p] != p) { o.parityMove = m; break; }
+            }
+        }
+
+        // Base 3-cycles: commutators [X, Y] of a single-layer turn X with a
+        // turn B or a conjugate A B A' by an outer turn A. Kept when exactly
+        // three cubies of one orbit move and nothing else.
+        // the three turns of one layer are stored CW, CCW, Double
+        auto inverseIndex = [&](int m) { return m - t.moves[m].turn + (t.moves[m].turn == CW ? CCW : t.moves[m].turn == CCW ? CW : Double); };
+        vector<vector<uint8_t>> candidates;
+        for (int b = 0; b < moveCount; ++b) candidates.push_back({ uint8_t(b) });
+        for (int a = 0; a < moveCount; ++a)
+        {
+            if (t.moves[a].first != 0) continue;
+            for (int b = 0; b < moveCount; ++b)
+                if (t.moves[b].face != t.moves[a].face)
+                    candidates.push_back({ uint8_t(a), uint8_t(b), uint8_t(inverseIndex(a)) });
+        }
+        auto inverseSeq = [&](const vector<uint8_t>& seq) {
+            vector<uint8_t> inv(seq.rbegin(), seq.rend());
+            for (uint8_t& m : inv) m = uint8_t(inverseIndex(m));
+            return inv;
+        };
+
+        for (int x = 0; x < moveCount; ++x)
+            for (const vector<uint8_t>& y : candidates)
+            {
+                vector<uint8_t> seq = { uint8_t(x) };
+                seq.insert(seq.end(), y.begin(), y.end());
+                seq.push_back(uint8_t(inverseIndex(x)));
+                const vector<uint8_t> yInv = inverseSeq(y);
+                seq.insert(seq.end(), yInv.begin(), yInv.end());
+
+                NxNCube<N> c;
+                for (uint8_t m : seq) c.applyMove(t.moves[m]);
+                int moved = 0, orbit = -1, inOrbit[3], count = 0;
+                bool pure = true;
+                for (int q = 0; q < STICKERS && pure; ++q)
+                {
+                    if (c.id(q) == q) continue;
+                    ++moved;
+                    if (orbitOf[q] < 0) continue;
+                    if (orbit >= 0 && orbitOf[q] != orbit) pure = false;
+                    orbit = orbitOf[q];
+                    if (count < 3) inOrbit[count] = q;
+                    ++count;
+                }
+                if (!pure || orbit < 0 || count != 3) continue;
+                Orbit& o = t.orbits[orbit];
+                if (moved != 3 * (o.centers ? 1 : 2)) continue;
+
+                // the piece from c.id(q) now sits at q
+                const int p0 = inOrbit[0], p1 = c.id(p0), p2 = c.id(p1);
+                if (orbitOf[p1] != orbit || orbitOf[p2] != orbit || c.id(p2) != p0) continue;
+                const int i0 = indexIn[p0], i1 = indexIn[p1], i2 = indexIn[p2];
+                // p1 -> p0, p2 -> p1, p0 -> p2
+                for (int k = 0; k < 3; ++k)
+                {
+                    const int from[3] = { i1, i2, i0 }, to[3] = { i0, i1, i2 };
+                    vector<uint8_t>& slot = o.cycles[o.index(from[k], to[k], from[(k + 1) % 3])];
+                    if (slot.empty() || slot.size() > seq.size()) slot = seq;
+                }
+            }
+
+        // Setups: with C cycling a -> b -> c and a turn M carrying each
+        // place p to to[p], M' C M cycles to[a] -> to[b] -> to[c]. Breadth
+        // first from the base cycles until no triple is new.
+        for (Orbit& o : t.orbits)
+        {
+            const int n = int(o.places.size());
+            vector<int> frontier;
+            for (int k = 0; k < int(o.cycles.size()); ++k)
+                if (!o.cycles[k].empty()) frontier.push_back(k);
+            while (!frontier.empty())
+            {
+                vector<int> next;
+                for (int k : frontier)
+                {
+                    const int a = k / (n * n), b = k / n % n, c = k % n;
+                    for (int m = 0; m < moveCount; ++m)
+                    {
+                        const vector<int>& to = moveTo[m];
+                        const int na = indexIn[to[o.places[a]]], nb = indexIn[to[o.places[b]]],
+                                  nc = indexIn[to[o.places[c]]];
+                        vector<uint8_t>& slot = o.cycles[o.index(na, nb, nc)];
+                        if (!slot.empty()) continue;
+                        slot.push_back(uint8_t(inverseIndex(m)));
+                        slot.insert(slot.end(), o.cycles[k].begin(), o.cycles[k].end());
+                        slot.push_back(uint8_t(m));
+                        next.push_back(o.index(na, nb, nc));
+                    }
+                }
+                frontier.swap(next);
+            }
+        }
+        return t;
+    }
+
+    template <int N>
+    const ReductionTables& reductionTables()
+    {
+        static const ReductionTables tables = buildTables<N>();
+        return tables;
+    }
+}
+
+void initReduction(int n)
+{
+    switch (n) {
+    case 2: reductionTables<2>(); break;
+    case 3: reductionTables<3>(); break;
+    case 4: reductionTables<4>(); break;
+    case 5: reductionTables<5>(); break;
+    case 6: reductionTables<6>(); break;
+    case 7: reductionTables<7>(); break;
+    default: break;
+    }
+}
+
+// ----- Solver -----
+
+// drops turns that cancel and merges turns of the same layers
+static void appendMerged(vector<LayerMove>& out, const LayerMove& m)
+{
+    static const int kQuarters[3] = { 1, 3, 2 }; // CW, CCW, Double
+    if (!out.empty())
+    {
+        LayerMove& prev = out.back();
+        if (prev.face == m.face && prev.first == m.first && prev.last == m.last)
+        {
+            const int q = (kQuarters[prev.turn] + kQuarters[m.turn]) % 4;
+            if (q == 0) out.pop_back();
+            else prev.turn = q == 1 ? CW : q == 2 ? Double : CCW;
+            return;
+        }
+    }
+    out.push_back(m);
+}
+
+template <int N>
+vector<LayerMove> ReductionSolver<N>::solve(const NxNCube<N>& start)
+{
+    stats_ = Stats();
+    if (start.isSolved()) return {};
+    const ReductionTables& t = reductionTables<N>();
+
+    NxNCube<N> cube = start;
+    vector<LayerMove> solution;
+    auto play = [&](const LayerMove& m) { cube.applyMove(m); appendMerged(solution, m); };
+
+    // odd sizes: the fixed centres back home with middle slices, the only
+    // turns that move them
+    if (N % 2 == 1)
+    {
+        constexpr int mid = N / 2;
+        auto centresHome = [&] {
+            for (int f = 0; f < Face::Count; ++f)
+            {
+                const int s = f * N * N + mid * N + mid;
+                if (cube.id(s) != s) return false;
+            }
+            return true;
+        };
+        const Face axes[3] = { Up, Right, Front };
+        vector<LayerMove> path;
+        std::function<bool(int)> search = [&](int depth) {
+            if (centresHome()) return true;
+            if (depth == 0) return false;
+            for (Face f : axes)
+            {
+                if (!path.empty() && path.back().face == f) continue;
+                for (int turn = 0; turn < 3; ++turn)
+                {
+                    LayerMove m{f, uint8_t(mid), uint8_t(mid), Turn(turn)};
+                    cube.applyMove(m);
+                    path.push_back(m);
+                    if (search(depth - 1)) return true;
+                    path.pop_back();
+                    cube.applyMove(inverseOf(m));
+                }
+            }
+            return false;
+        };
+        for (int depth = 0; depth <= 3 && !search(depth); ++depth) {}
+        for (const LayerMove& m : path) appendMerged(solution, m);
+        stats_.frameMoves = int(path.size());
+    }
+
+    // the 3x3 skeleton; even sizes have no middle edges and see solved ones
+    auto skeleton = [&] {
+        array<Color, STICKER_COUNT> colors;
+        auto at = [](int i) { return i == 0 ? 0 : i == 2 ? N - 1 : N / 2; };
+        for (int f = 0; f < Face::Count; ++f)
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 3; ++c)
+                {
+                    const bool virtualPiece = N % 2 == 0 && (r == 1 || c == 1);
+                    colors[stickerIndex(Face(f), r, c)] =
+                        virtualPiece ? NxNCube<N>::colorOf(f * N * N) : cube.sticker(Face(f), at(r), at(c));
+                }
+        return RubiksCube(colors);
+    };
+    RubiksCube small = skeleton();
+    if (N % 2 == 0 && !CubieCube(small).isValid())
+    {
+        play(LayerMove{Up, 0, 0, CW}); // an odd corner permutation, with the edges held solved
+        ++stats_.skeletonMoves;
+        small = skeleton();
+    }
+    if (!small.isSolved())
+    {
+        vector<Move> moves = skeleton_.solve(small);
+        if (moves.empty()) return {};
+        for (const Move& m : moves) play(outerLayer(m));
+        stats_.skeletonMoves += int(moves.size());
+    }
+
+    // wings, then centres, each orbit on its own
+    for (const Orbit& o : t.orbits)
+    {
+        const int n = int(o.places.size());
+        vector<int> indexOf(NxNCube<N>::STICKERS, -1);
+        for (int i = 0; i < n; ++i) indexOf[o.places[i]] = i;
+
+        // what sits at place i, and whether it belongs there
+        auto label = [&](int i) {
+            const int id = cube.id(o.places[i]);
+            return o.centers ? id / (N * N) : indexOf[id];
+        };
+        auto fits = [&](int lab, int i) { return o.centers ? lab == o.places[i] / (N * N) : lab == i; };
+
+        if (!o.centers)
+        {
+            // the permutation is odd when n minus its cycle count is
+            vector<bool> seen(n, false);
+            int cycles = 0;
+            for (int i = 0; i < n; ++i)
+            {
+                if (seen[i]) continue;
+                ++cycles;
+                for (int j = i; !seen[j]; j = label(j)) seen[j] = true;
+            }
+            if ((n - cycles) % 2 == 1)
+            {
+                if (o.parityMove < 0) return {};
+                play(t.moves[o.parityMove]);
+                ++stats_.parityTurns;
+            }
+        }
+
+        for (int guard = 0; guard < 4 * n; ++guard)
+        {
+            vector<int> labels(n);
+            int unsolved = -1;
+            for (int i = 0; i < n; ++i)
+            {
+                labels[i] = label(i);
+                if (unsolved < 0 && !fits(labels[i], i)) unsolved = i;
+            }
+            if (unsolved < 0) break;
+
+            // the cycle q -> i -> r that fixes the most places, then the shortest
+            const int i = unsolved;
+            const vector<uint8_t>* best = nullptr;
+            int bestGain = 0;
+            for (int q = 0; q < n; ++q)
+            {
+                if (q == i || !fits(labels[q], i)) continue;
+                for (int r = 0; r < n; ++r)
+                {
+                    if (r == i || r == q) continue;
+                    const vector<uint8_t>& seq = o.cycles[o.index(q, i, r)];
+                    if (seq.empty()) continue;
+                    const int gain = 1 - int(fits(labels[i], i))
+                                   + int(fits(labels[i], r)) - int(fits(labels[r], r))
+                                   + int(fits(labels[r], q)) - int(fits(labels[q], q));
+                    if (gain > bestGain || (gain == bestGain && best && seq.size() < best->size()))
+                    {
+                        best = &seq;
+                        bestGain = gain;
+                    }
+                }
+            }
+            if (!best) return {};
+            for (uint8_t m : *best) play(t.moves[m]);
+            ++(o.centers ? stats_.centerCycles : stats_.wingCycles);
+        }
+    }
+
+    if (!cube.isSolved()) return {};
+    return solution;
+}
+
+template class ReductionSolver<2>;
+template class ReductionSolver<3>;
+template class ReductionSolver<4>;
+template class ReductionSolver<5>;
+template class ReductionSolver<6>;
+template class ReductionSolver<7>;
+
+// ----- Self Check -----
+
+template <int N>
+static bool checkSize(std::ostream& out, std::mt19937& rng)
+{
+    bool ok = true;
+    std::uniform_int_distribution<int> faceDist(0, Face::Count - 1), turnDist(0, 2), layerDist(0, N - 1);
+    auto randomMoves = [&](int count) {
+        vector<LayerMove> seq;
+        for (int i = 0; i < count; ++i)
+        {
+            LayerMove m{Face(faceDist(rng)), 0, 0, Turn(turnDist(rng))};
+            const int a = layerDist(rng), b = layerDist(rng);
+            // single layers, and wide turns from the face in
+            if (turnDist(rng) == 0) m.last = uint8_t(std::max(a, b));
+            else m.first = m.last = uint8_t(a);
+            seq.push_back(m);
+        }
+        return seq;
+    };
+
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        vector<LayerMove> seq = randomMoves(30), parsed;
+        NxNCube<N> c;
+        c.applyMoves(seq);
+        for (auto it = seq.rbegin(); it != seq.rend(); ++it) c.applyMove(inverseOf(*it));
+        if (!(c == NxNCube<N>())) { out << N << "x" << N << ": turns and their inverses do not cancel\n"; ok = false; }
+
+        if (!parseLayerMoves(layerMovesToString(seq), N, parsed)) {
+            out << N << "x" << N << ": cannot read back " << layerMovesToString(seq) << "\n";
+            ok = false;
+        } else {
+            NxNCube<N> a, b;
+            a.applyMoves(seq);
+            b.applyMoves(parsed);
+            if (!(a == b)) { out << N << "x" << N << ": notation round trip changes " << layerMovesToString(seq) << "\n"; ok = false; }
+        }
+        if (!ok) return false;
+    }
+
+    ReductionSolver<N> solver;
+    for (int trial = 0; trial < 3; ++trial)
+    {
+        vector<LayerMove> scramble = randomMoves(60);
+        NxNCube<N> c;
+        c.applyMoves(scramble);
+        vector<LayerMove> sol = solver.solve(c);
+        c.applyMoves(sol);
+        if (!c.isSolved()) {
+            out << N << "x" << N << ": reduction solver left " << layerMovesToString(scramble) << " unsolved\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool nxnSelfCheck(std::ostream& out)
+{
+    bool ok = true;
+    std::mt19937 rng(2024);
+
+    // the generated geometry agrees with the 3x3's own sticker moves
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1);
+    NxNCube<3> nxn;
+    RubiksCube cube;
+    for (int i = 0; i < 500 && ok; ++i)
+    {
+        const Move m = allMoves[moveDist(rng)];
+        nxn.applyMove(outerLayer(m));
+        cube.applyMove(m.face, m.turn);
+        for (int s = 0; s < STICKER_COUNT; ++s)
+            if (nxn.sticker(Face(s / 9), s % 9 / 3, s % 3) != cube.sticker(Face(s / 9), s % 9 / 3, s % 3)) {
+                out << "3x3 layer turns disagree with RubiksCube after " << moveToString(m) << "\n";
+                ok = false;
+                break;
+            }
+    }
+
+    ok = checkSize<2>(out, rng) && ok;
+    ok = checkSize<3>(out, rng) && ok;
+    ok = checkSize<4>(out, rng) && ok;
+    ok = checkSize<5>(out, rng) && ok;
+    ok = checkSize<6>(out, rng) && ok;
+    ok = checkSize<7>(out, rng) && ok;
+    if (ok) out << "NxN self-check passed (2x2 to 7x7)\n";
+    return ok;
+}
@@ -0,0 +1,51 @@
+#ifndef NXNSOLVER_HPP
+#define NXNSOLVER_HPP
+
+#include "nxncube.hpp"
+#include "solver.hpp"
+#include <iosfwd>
+
+///// REDUCTION SOLVER /////
+
+// Solves an N x N cube by reducing it to the 3x3 inside it. Under outer
+// turns the corners and, on odd sizes, the middle edges and fixed centres
+// move exactly like a 3x3, so that skeleton is solved first with the
+// two-phase search; even sizes fill in solved edges and fix an odd corner
+// permutation with one quarter turn. Every other piece lies in an orbit of
+// wings or centres that pure 3-cycle commutators can rearrange without
+// disturbing the rest. A wing orbit left an odd permutation gets one inner
+// slice quarter turn, then both kinds are cycled home greedily from a
+// table of commutators with setup moves, built the first time a size is
+// solved. Solutions run to a few hundred moves; the point is throughput.
+template <int N>
+class ReductionSolver
+{
+public:
+    struct Stats
+    {
+        int frameMoves = 0;    // middle slices putting the fixed centres back (odd N)
+        int skeletonMoves = 0; // two-phase moves, plus a parity quarter turn on even N
+        int parityTurns = 0;   // inner slices making wing orbits even
+        int wingCycles = 0;
+        int centerCycles = 0;
+    };
+
+    explicit ReductionSolver(double skeletonMs = 50.0) : skeleton_(30, skeletonMs) {}
+
+    // empty when already solved, and when no solution was found
+    vector<LayerMove> solve(const NxNCube<N>& cube);
+    const Stats& lastStats() const { return stats_; }
+
+private:
+    TwoPhaseSolver skeleton_;
+    Stats stats_;
+};
+
+// builds the commutator table for size n (2..7) before workers need it
+void initReduction(int n);
+
+// NxNCube<3> against RubiksCube, inverse and wide turns, notation round
+// trips and solves of random scrambles on every size; prints failures
+bool nxnSelfCheck(std::ostream& out);
+
+#endif // NXNSOLVER_HPP
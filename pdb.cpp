@@ -0,0 +1,529 @@
+#include "pdb.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ----- File Format -----
+
+struct PdbHeader
+{
+    char     magic[8];   // "RUBIKPDB"
+    uint32_t version;
+    uint32_t kind;       // which table, PDB_KIND_* or EdgePattern::kind()
+    uint64_t entries;
+    uint64_t checksum;   // FNV-1a over the packed data
+    uint32_t layers;     // BFS depths complete
+    uint32_t complete;   // 0 for a resumable checkpoint
+};
+
+static const char kPdbMagic[8] = { 'R','U','B','I','K','P','D','B' };
+
+static uint64_t fnv1a(const uint8_t* data, size_t n)
+{
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < n; ++i) { h ^= data[i]; h *= 1099511628211ULL; }
+    return h;
+}
+
+// ----- PatternDatabase -----
+
+PatternDatabase::~PatternDatabase()
+{
+    release();
+}
+
+void PatternDatabase::release()
+{
+#ifdef _WIN32
+    if (mapBase_)    UnmapViewOfFile(mapBase_);
+    if (mapHandle_)  CloseHandle(mapHandle_);
+    if (fileHandle_) CloseHandle(fileHandle_);
+    mapHandle_ = fileHandle_ = nullptr;
+#else
+    if (mapBase_) munmap(mapBase_, mapSize_);
+#endif
+    mapBase_ = nullptr;
+    mapSize_ = 0;
+    owned_.clear();
+    owned_.shrink_to_fit();
+    data_ = nullptr;
+    entries_ = 0;
+}
+
+void PatternDatabase::allocate(uint64_t entries)
+{
+    release();
+    owned_.assign(packedBytes(entries), 0xFF);
+    data_ = owned_.data();
+    entries_ = entries;
+}
+
+bool PatternDatabase::write(const std::string& path, uint32_t kind, int layers, bool complete) const
+{
+    if (!data_) return false;
+
+    PdbHeader hdr{};
+    std::memcpy(hdr.magic, kPdbMagic, sizeof(hdr.magic));
+    hdr.version  = VERSION;
+    hdr.kind     = kind;
+    hdr.entries  = entries_;
+    hdr.checksum = fnv1a(data_, packedBytes(entries_));
+    hdr.layers   = uint32_t(layers);
+    hdr.complete = complete ? 1 : 0;
+
+    // write beside the target and rename, so a crash never leaves half a table
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              std::fwrite(data_, 1, packedBytes(entries_), f) == packedBytes(entries_);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) { std::remove(tmp.c_str()); return false; }
+
+    std::remove(path.c_str());
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool PatternDatabase::save(const std::string& path, uint32_t kind) const
+{
+    return write(path, kind, 0, true);
+}
+
+bool PatternDatabase::saveCheckpoint(const std::string& path, uint32_t kind, int layers) const
+{
+    return write(path, kind, layers, false);
+}
+
+bool PatternDatabase::load(const std::string& path, uint32_t kind, uint64_t entries)
+{
+    int layers = 0;
+    return map(path, kind, entries, true, layers);
+}
+
+// a checkpoint is copied into owned memory so the build can keep writing
+bool PatternDatabase::loadCheckpoint(const std::string& path, uint32_t kind, uint64_t entries, int& layers)
+{
+    if (!map(path, kind, entries, false, layers)) return false;
+    vector<uint8_t> copy(data_, data_ + packedBytes(entries));
+    release();
+    owned_ = std::move(copy);
+    data_ = owned_.data();
+    entries_ = entries;
+    return true;
+}
+
+bool PatternDatabase::map(const std::string& path, uint32_t kind, uint64_t entries, bool complete, int& layers)
+{
+    release();
+    const size_t total = sizeof(PdbHeader) + packedBytes(entries);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || uint64_t(fileSize.QuadPart) != total) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(file); return false; }
+    void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) { CloseHandle(mapping); CloseHandle(file); return false; }
+    fileHandle_ = file;
+    mapHandle_  = mapping;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || uint64_t(st.st_size) != total) { close(fd); return false; }
+    void* base = mmap(nullptr, total, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+#endif
+    mapBase_ = base;
+    mapSize_ = total;
+
+    const PdbHeader* hdr = static_cast<const PdbHeader*>(base);
+    const uint8_t* body = static_cast<const uint8_t*>(base) + sizeof(PdbHeader);
+    if (std::memcmp(hdr->magic, kPdbMagic, sizeof(hdr->magic)) != 0 ||
+        hdr->version != VERSION || hdr->kind != kind || hdr->entries != entries ||
+        hdr->complete != (complete ? 1u : 0u) ||
+        hdr->checksum != fnv1a(body, packedBytes(entries)))
+    {
+        release();
+        return false;
+    }
+
+    layers = int(hdr->layers);
+    data_ = body;
+    entries_ = entries;
+    return true;
+}
+
+PdbOptions& pdbOptions()
+{
+    static PdbOptions options;
+    return options;
+}
+
+// ----- Breadth-First Build -----
+
+// nibble access shared between build threads
+static int loadNibble(uint8_t* data, uint64_t i)
+{
+    uint8_t b = std::atomic_ref<uint8_t>(data[i >> 1]).load(std::memory_order_relaxed);
+    return (i & 1) ? (b >> 4) : (b & 0xF);
+}
+
+// writes value into an EMPTY nibble, false if it was already set
+static bool claimNibble(uint8_t* data, uint64_t i, int value)
+{
+    std::atomic_ref<uint8_t> ref(data[i >> 1]);
+    uint8_t b = ref.load(std::memory_order_relaxed);
+    while (true)
+    {
+        int cur = (i & 1) ? (b >> 4) : (b & 0xF);
+        if (cur != PatternDatabase::EMPTY) return false;
+        uint8_t next = (i & 1) ? uint8_t((b & 0x0F) | (value << 4)) : uint8_t((b & 0xF0) | value);
+        if (ref.compare_exchange_weak(b, next, std::memory_order_relaxed)) return true;
+    }
+}
+
+static int buildThreads()
+{
+    int n = pdbOptions().threads;
+    if (n <= 0) n = int(std::thread::hardware_concurrency());
+    return n > 0 ? n : 1;
+}
+
+// Fills db with exact distances from start, one depth layer per pass with
+// the index range handed out to threads in chunks. Early layers expand
+// outward; once most entries are known it is cheaper to scan the empty ones
+// for a neighbour on the current layer. Progress is checkpointed to
+// path.partial so an interrupted build picks up at the last finished layer;
+// a cancelled build is checkpointed at once, released and reports false.
+// expand(idx, out) writes the MOVE_COUNT neighbours of idx.
+template <typename Expand>
+static bool bfsBuild(PatternDatabase& db, const std::string& path, uint32_t kind,
+                     uint64_t entries, uint64_t start, const std::atomic<bool>* cancel, Expand expand)
+{
+    auto cancelled = [cancel]() { return cancel && cancel->load(std::memory_order_relaxed); };
+    if (cancelled()) return false;
+
+    const std::string partial = path + ".partial";
+    int layers = 0;
+    if (db.loadCheckpoint(partial, kind, entries, layers))
+    {
+        std::clog << "  resuming " << path << " after depth " << layers << "\n";
+    }
+    else
+    {
+        db.allocate(entries);
+        claimNibble(db.mutableData(), start, 0);
+        layers = 0;
+    }
+    uint8_t* data = db.mutableData();
+
+    uint64_t filled = 0;
+    for (uint64_t i = 0; i < entries; ++i) filled += loadNibble(data, i) != PatternDatabase::EMPTY;
+
+    const int threads = buildThreads();
+    const uint64_t CHUNK = uint64_t(1) << 16;
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+
+    for (int depth = layers; filled < entries; ++depth)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        const bool backward = filled > entries / 2;
+        std::atomic<uint64_t> nextChunk{0};
+        std::atomic<uint64_t> found{0};
+
+        auto worker = [&]()
+        {
+            uint64_t local = 0;
+            uint64_t out[MOVE_COUNT];
+            while (true)
+            {
+                uint64_t begin = nextChunk.fetch_add(CHUNK);
+                if (begin >= entries || cancelled()) break;
+                uint64_t end = std::min(entries, begin + CHUNK);
+                for (uint64_t idx = begin; idx < end; ++idx)
+                {
+                    int v = loadNibble(data, idx);
+                    if (!backward)
+                    {
+                        if (v != depth) continue;
+                        expand(idx, out);
+                        for (int m = 0; m < MOVE_COUNT; ++m)
+                            if (claimNibble(data, out[m], depth + 1)) ++local;
+                    }
+                    else
+                    {
+                        if (v != PatternDatabase::EMPTY) continue;
+                        expand(idx, out);
+                        for (int m = 0; m < MOVE_COUNT; ++m)
+                        {
+                            if (loadNibble(data, out[m]) == depth)
+                            {
+                                if (claimNibble(data, idx, depth + 1)) ++local;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            found += local;
+        };
+
+        vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (std::thread& t : pool) t.join();
+
+        // entries claimed in an unfinished layer are exact, so the resumed
+        // build simply redoes that layer around them
+        if (cancelled())
+        {
+            db.saveCheckpoint(partial, kind, depth);
+            db.release();
+            std::clog << "  stopped at depth " << depth << ", progress kept in " << partial << "\n";
+            return false;
+        }
+
+        filled += found;
+        auto t1 = std::chrono::steady_clock::now();
+        std::clog << "  depth " << depth + 1 << ": " << found << " states ("
+                  << std::chrono::duration<double>(t1 - t0).count() << " s)\n";
+        if (found == 0) break;
+
+        if (filled < entries && t1 - lastCheckpoint > std::chrono::seconds(10))
+        {
+            db.saveCheckpoint(partial, kind, depth + 1);
+            lastCheckpoint = std::chrono::steady_clock::now();
+        }
+    }
+
+    bool saved = db.save(path, kind);
+    std::remove(partial.c_str());
+    if (!saved)
+    {
+        std::clog << "Could not write " << path << ", keeping table in memory only\n";
+        return true;
+    }
+    // switch to the mapped copy so the heap table is released
+    return db.load(path, kind, entries);
+}
+
+static std::string tablePath(const std::string& name)
+{
+    return pdbOptions().directory + "/" + name;
+}
+
+// ----- Corner Database -----
+
+static PatternDatabase g_cornerPDB;
+
+bool initCornerPDB(const std::atomic<bool>* cancel)
+{
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+    if (g_cornerPDB.isReady()) return true;
+    initCoordTables();
+
+    const std::string path = tablePath("corners.pdb");
+    if (g_cornerPDB.load(path, PDB_KIND_CORNERS, N_CORNER_STATES)) return true;
+
+    std::clog << "Building corner pattern database (" << N_CORNER_STATES << " states)\n";
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = bfsBuild(g_cornerPDB, path, PDB_KIND_CORNERS, N_CORNER_STATES, 0, cancel,
+        [](uint64_t idx, uint64_t out[MOVE_COUNT]) {
+            uint64_t perm = idx / N_TWIST, twist = idx % N_TWIST;
+            for (int m = 0; m < MOVE_COUNT; ++m)
+                out[m] = uint64_t(cornerPermMove[perm][m]) * N_TWIST + twistMove[twist][m];
+        });
+    if (!ok) return false;
+    auto t1 = std::chrono::steady_clock::now();
+    std::clog << "Corner pattern database built in "
+              << std::chrono::duration<double>(t1 - t0).count() << " s\n";
+    return true;
+}
+
+const PatternDatabase& cornerPDB()
+{
+    return g_cornerPDB;
+}
+
+// ----- Edge Databases -----
+
+// where each slot's edge goes under a move, and whether it flips
+static uint8_t edgeSlotTo[MOVE_COUNT][CubieCube::EDGES];
+static uint8_t edgeFlipTo[MOVE_COUNT][CubieCube::EDGES];
+
+static void buildEdgeSlotTables()
+{
+    for (int m = 0; m < MOVE_COUNT; ++m)
+    {
+        CubieCube c;
+        c.applyMove(m);
+        for (int t = 0; t < CubieCube::EDGES; ++t)
+        {
+            edgeSlotTo[m][c.edgePerm(t)] = uint8_t(t);
+            edgeFlipTo[m][c.edgePerm(t)] = uint8_t(c.edgeOri(t));
+        }
+    }
+}
+
+// partial permutation rank of the tracked edges' slots, then their flips
+static uint64_t edgePatternRank(const int* slots, const int* flips, int count)
+{
+    uint32_t used = 0, ori = 0;
+    uint64_t rank = 0;
+    for (int j = 0; j < count; ++j)
+    {
+        int s = slots[j];
+        int digit = s - std::popcount(used & ((1u << s) - 1));
+        rank = rank * uint64_t(CubieCube::EDGES - j) + uint64_t(digit);
+        used |= 1u << s;
+        ori = (ori << 1) | uint32_t(flips[j]);
+    }
+    return (rank << count) | ori;
+}
+
+static void edgePatternUnrank(uint64_t idx, int count, int* slots, int* flips)
+{
+    uint64_t rank = idx >> count;
+    for (int j = count - 1; j >= 0; --j)
+    {
+        flips[j] = int(idx & 1);
+        idx >>= 1;
+    }
+
+    int digits[CubieCube::EDGES];
+    for (int j = count - 1; j >= 0; --j)
+    {
+        digits[j] = int(rank % uint64_t(CubieCube::EDGES - j));
+        rank /= uint64_t(CubieCube::EDGES - j);
+    }
+
+    uint32_t used = 0;
+    for (int j = 0; j < count; ++j)
+    {
+        int k = digits[j];
+        for (int s = 0; s < CubieCube::EDGES; ++s)
+        {
+            if (used & (1u << s)) continue;
+            if (k-- == 0) { slots[j] = s; used |= 1u << s; break; }
+        }
+    }
+}
+
+uint64_t EdgePattern::states() const
+{
+    uint64_t n = uint64_t(1) << count;
+    for (int j = 0; j < count; ++j) n *= uint64_t(CubieCube::EDGES - j);
+    return n;
+}
+
+uint64_t EdgePattern::solvedIndex() const
+{
+    int slots[CubieCube::EDGES], flips[CubieCube::EDGES] = {};
+    for (int j = 0; j < count; ++j) slots[j] = first + j;
+    return edgePatternRank(slots, flips, count);
+}
+
+uint64_t EdgePattern::index(const CoordCube& c) const
+{
+    int slots[CubieCube::EDGES], flips[CubieCube::EDGES];
+    for (int j = 0; j < count; ++j)
+    {
+        slots[j] = edgeSlotOf(c.edgeGroup, first + j);
+        flips[j] = flipAtSlot(c.flip, slots[j]);
+    }
+    return edgePatternRank(slots, flips, count);
+}
+
+static PatternDatabase g_edgePDB[2];
+static EdgePattern     g_edgePattern[2];
+
+bool initEdgePDBs(const std::atomic<bool>* cancel)
+{
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+    if (g_edgePDB[0].isReady() && g_edgePDB[1].isReady()) return true;
+    initCoordTables();
+    buildEdgeSlotTables();
+
+    // largest split whose two packed tables fit the budget
+    const size_t budget = pdbOptions().memoryBudget;
+    auto packed = [](const EdgePattern& p) { return size_t((p.states() + 1) / 2); };
+    EdgePattern big{0, 7}, small{7, 5};
+    if (packed(big) + packed(small) > budget)
+    {
+        big = {0, 6};
+        small = {6, 6};
+        if (packed(big) + packed(small) > budget)
+        {
+            std::clog << "Edge pattern databases need " << ((packed(big) + packed(small)) >> 20)
+                      << " MB, over the " << (budget >> 20) << " MB budget\n";
+            return false;
+        }
+    }
+    g_edgePattern[0] = big;
+    g_edgePattern[1] = small;
+
+    for (int which = 0; which < 2; ++which)
+    {
+        const EdgePattern& p = g_edgePattern[which];
+        const std::string path = tablePath("edges-" + std::to_string(p.first) + "-" +
+                                           std::to_string(p.count) + ".pdb");
+        if (g_edgePDB[which].load(path, p.kind(), p.states())) continue;
+
+        std::clog << "Building edge pattern database for edges " << p.first << ".."
+                  << p.first + p.count - 1 << " (" << p.states() << " states, "
+                  << buildThreads() << " threads)\n";
+        auto t0 = std::chrono::steady_clock::now();
+        const int count = p.count;
+        bool ok = bfsBuild(g_edgePDB[which], path, p.kind(), p.states(), p.solvedIndex(), cancel,
+            [count](uint64_t idx, uint64_t out[MOVE_COUNT]) {
+                int slots[CubieCube::EDGES], flips[CubieCube::EDGES];
+                int nextSlots[CubieCube::EDGES], nextFlips[CubieCube::EDGES];
+                edgePatternUnrank(idx, count, slots, flips);
+                for (int m = 0; m < MOVE_COUNT; ++m)
+                {
+                    for (int j = 0; j < count; ++j)
+                    {
+                        nextSlots[j] = edgeSlotTo[m][slots[j]];
+                        nextFlips[j] = flips[j] ^ edgeFlipTo[m][slots[j]];
+                    }
+                    out[m] = edgePatternRank(nextSlots, nextFlips, count);
+                }
+            });
+        if (!ok) return false;
+        auto t1 = std::chrono::steady_clock::now();
+        std::clog << "Edge pattern database built in "
+                  << std::chrono::duration<double>(t1 - t0).count() << " s\n";
+    }
+    return true;
+}
+
+const PatternDatabase& edgePDB(int which)
+{
+    return g_edgePDB[which];
+}
+
+const EdgePattern& edgePattern(int which)
+{
+    return g_edgePattern[which];
+}
@@ -0,0 +1,125 @@
+#ifndef PDB_HPP
+#define PDB_HPP
+
+#include "coords.hpp"
+#include <atomic>
+
+///// PATTERN DATABASE /////
+
+// Exact distances for a sub-problem of the cube, 4 bits per entry, or 2 for
+// tables small enough to hold every state that store distances mod 3. Built
+// by breadth-first search, saved with a versioned checksummed header and
+// mapped back in read-only on later runs.
+class PatternDatabase
+{
+public:
+    static constexpr uint32_t VERSION = 2;
+    static constexpr uint8_t  EMPTY   = 0xF;
+
+    explicit PatternDatabase(int bitsPerEntry = 4) : bits_(bitsPerEntry) {}
+    ~PatternDatabase();
+    PatternDatabase(const PatternDatabase&) = delete;
+    PatternDatabase& operator=(const PatternDatabase&) = delete;
+
+    // owned table with every entry EMPTY
+    void allocate(uint64_t entries);
+    // drops the table, owned or mapped
+    void release();
+
+    // maps a finished file written by save(); false if missing, stale or corrupt
+    bool load(const std::string& path, uint32_t kind, uint64_t entries);
+    bool save(const std::string& path, uint32_t kind) const;
+
+    // partial tables: layers is the last BFS depth that is complete
+    bool loadCheckpoint(const std::string& path, uint32_t kind, uint64_t entries, int& layers);
+    bool saveCheckpoint(const std::string& path, uint32_t kind, int layers) const;
+
+    bool     isReady() const { return data_ != nullptr; }
+    uint64_t size() const    { return entries_; }
+    size_t   bytes() const   { return packedBytes(entries_); }
+
+    // 4-bit tables
+    int get(uint64_t index) const
+    {
+        uint8_t b = data_[index >> 1];
+        return (index & 1) ? (b >> 4) : (b & 0xF);
+    }
+    // 2-bit tables, lowest pair first
+    int get2(uint64_t index) const
+    {
+        return (data_[index >> 2] >> (2 * (index & 3))) & 3;
+    }
+
+    // only valid on an owned table
+    uint8_t* mutableData() { return owned_.empty() ? nullptr : owned_.data(); }
+
+private:
+    size_t packedBytes(uint64_t entries) const { return size_t((entries * uint64_t(bits_) + 7) / 8); }
+    bool write(const std::string& path, uint32_t kind, int layers, bool complete) const;
+    bool map(const std::string& path, uint32_t kind, uint64_t entries, bool complete, int& layers);
+
+    const uint8_t*       data_ = nullptr;
+    vector<uint8_t>      owned_;
+    uint64_t             entries_ = 0;
+    int                  bits_ = 4;
+
+    // mapping state when data_ points into a file
+    void*                mapBase_ = nullptr;
+    size_t               mapSize_ = 0;
+#ifdef _WIN32
+    void*                fileHandle_ = nullptr;
+    void*                mapHandle_  = nullptr;
+#endif
+};
+
+// where tables live, how many threads build them and how much memory the
+// edge tables may take; main() fills this from the command line
+struct PdbOptions
+{
+    std::string directory = ".";
+    size_t      memoryBudget = size_t(64) << 20;
+    int         threads = 0; // 0 = hardware concurrency
+};
+
+PdbOptions& pdbOptions();
+
+///// CORNER DATABASE /////
+
+// every corner permutation x twist, 8! * 3^7 entries, ~42 MB packed
+static constexpr uint64_t N_CORNER_STATES = uint64_t(N_CORNER_PERM) * N_TWIST;
+static constexpr uint32_t PDB_KIND_CORNERS = 1;
+
+inline uint64_t cornerIndex(const CoordCube& c)
+{
+    return uint64_t(c.cornerPerm) * N_TWIST + c.twist;
+}
+
+// Maps the corner table, building and saving it first if needed. A build
+// stops soon after cancel is set, keeps its finished layers in the .partial
+// checkpoint for the next call and returns false.
+bool initCornerPDB(const std::atomic<bool>* cancel = nullptr);
+const PatternDatabase& cornerPDB();
+
+///// EDGE DATABASES /////
+
+// Edges first..first+count-1 tracked by slot and flip. Two patterns split
+// the 12 edges so their tables can be max()ed with the corner table.
+struct EdgePattern
+{
+    int first = 0;
+    int count = 0;
+
+    uint32_t kind() const { return 2u | (uint32_t(first) << 8) | (uint32_t(count) << 16); }
+    uint64_t states() const; // 12!/(12-count)! * 2^count
+    uint64_t solvedIndex() const;
+    uint64_t index(const CoordCube& c) const;
+};
+
+// picks 7+5 when it fits the memory budget, 6+6 otherwise, and maps or
+// builds both tables; false if even 6+6 does not fit or the build was
+// cancelled as with initCornerPDB
+bool initEdgePDBs(const std::atomic<bool>* cancel = nullptr);
+const PatternDatabase& edgePDB(int which);
+const EdgePattern&     edgePattern(int which);
+
+#endif // PDB_HPP
@@ -0,0 +1,368 @@
+#include "pocket.hpp"
+#include "threadpool.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+// ----- Coordinates -----
+
+namespace
+{
+    // the turns that keep DBL home, in table column order
+    const Face kPocketFaces[3] = { Up, Right, Front };
+    constexpr int POCKET_MOVES = 9;
+    constexpr int DBL = 6;
+
+    Move pocketMove(int m) { return Move{ kPocketFaces[m / 3], Turn(m % 3) }; }
+
+    // slots and cubies 0..5 and 7 renumbered 0..6
+    int packed(int slot) { return slot < DBL ? slot : slot - 1; }
+    int unpacked(int i)  { return i < DBL ? i : i + 1; }
+
+    int permCoord(const CubieCube& c)
+    {
+        int p[7];
+        for (int i = 0; i < 7; ++i) p[i] = packed(c.cornerPerm(unpacked(i)));
+        int rank = 0;
+        for (int i = 0; i < 7; ++i)
+        {
+            int smaller = 0;
+            for (int j = i + 1; j < 7; ++j) smaller += p[j] < p[i];
+            rank = rank * (7 - i) + smaller;
+        }
+        return rank;
+    }
+
+    void setPermCoord(CubieCube& c, int rank)
+    {
+        int digits[7];
+        for (int i = 6; i >= 0; --i) { digits[i] = rank % (7 - i); rank /= 7 - i; }
+        bool used[7] = {};
+        for (int i = 0; i < 7; ++i)
+        {
+            // the digits[i]-th value not taken yet
+            int v = -1;
+            for (int k = digits[i]; ; ) { ++v; if (!used[v] && k-- == 0) break; }
+            used[v] = true;
+            c.setCorner(unpacked(i), unpacked(v), c.cornerOri(unpacked(i)));
+        }
+    }
+
+    int twistCoord6(const CubieCube& c)
+    {
+        int t = 0;
+        for (int i = 0; i < DBL; ++i) t = 3 * t + c.cornerOri(i);
+        return t;
+    }
+
+    void setTwistCoord6(CubieCube& c, int twist)
+    {
+        int sum = 0;
+        for (int i = DBL - 1; i >= 0; --i)
+        {
+            c.setCorner(i, c.cornerPerm(i), twist % 3);
+            sum += twist % 3;
+            twist /= 3;
+        }
+        c.setCorner(DBL, c.cornerPerm(DBL), 0);
+        c.setCorner(7, c.cornerPerm(7), (3 - sum % 3) % 3);
+    }
+
+    struct PocketMoves
+    {
+        uint16_t perm[N_POCKET_PERM][POCKET_MOVES];
+        uint16_t twist[N_POCKET_TWIST][POCKET_MOVES];
+
+        PocketMoves()
+        {
+            for (int p = 0; p < N_POCKET_PERM; ++p)
+                for (int m = 0; m < POCKET_MOVES; ++m)
+                {
+                    CubieCube c;
+                    setPermCoord(c, p);
+                    c.applyMove(pocketMove(m).face, pocketMove(m).turn);
+                    perm[p][m] = uint16_t(permCoord(c));
+                }
+            for (int t = 0; t < N_POCKET_TWIST; ++t)
+                for (int m = 0; m < POCKET_MOVES; ++m)
+                {
+                    CubieCube c;
+                    setTwistCoord6(c, t);
+                    c.applyMove(pocketMove(m).face, pocketMove(m).turn);
+                    twist[t][m] = uint16_t(twistCoord6(c));
+                }
+        }
+
+        uint64_t next(uint64_t idx, int m) const
+        {
+            return uint64_t(perm[idx / N_POCKET_TWIST][m]) * N_POCKET_TWIST + twist[idx % N_POCKET_TWIST][m];
+        }
+    };
+
+    const PocketMoves& pocketMoves()
+    {
+        static const PocketMoves moves;
+        return moves;
+    }
+}
+
+int64_t pocketIndex(const CubieCube& c)
+{
+    if (c.cornerPerm(DBL) != DBL || c.cornerOri(DBL) != 0) return -1;
+    return int64_t(permCoord(c)) * N_POCKET_TWIST + twistCoord6(c);
+}
+
+// ----- Table -----
+
+static PatternDatabase g_pocketTable(2);
+
+// Exact depths one byte per state, one layer per pass with the index range
+// split across the pool, then packed to depth mod 3.
+static void buildPocketTable(PatternDatabase& db)
+{
+    const PocketMoves& mv = pocketMoves();
+    vector<uint8_t> depth(N_POCKET_STATES, 0xFF);
+    depth[0] = 0;
+
+    const int CHUNK = 1 << 16;
+    const int chunks = int((N_POCKET_STATES + CHUNK - 1) / CHUNK);
+    const int threads = pdbOptions().threads > 0 ? pdbOptions().threads : int(std::thread::hardware_concurrency());
+    WorkStealingPool pool(threads > 0 ? threads : 1);
+
+    for (int d = 0; ; ++d)
+    {
+        std::atomic<uint64_t> found{0};
+        pool.run(chunks, [&](int chunk) {
+            uint64_t local = 0;
+            const uint64_t end = std::min(N_POCKET_STATES, uint64_t(chunk + 1) * CHUNK);
+            for (uint64_t idx = uint64_t(chunk) * CHUNK; idx < end; ++idx)
+            {
+                if (depth[idx] != d) continue;
+                for (int m = 0; m < POCKET_MOVES; ++m)
+                {
+                    std::atomic_ref<uint8_t> slot(depth[mv.next(idx, m)]);
+                    uint8_t empty = 0xFF;
+                    if (slot.compare_exchange_strong(empty, uint8_t(d + 1), std::memory_order_relaxed)) ++local;
+                }
+            }
+            found += local;
+        });
+        if (found == 0) break;
+    }
+
+    db.allocate(N_POCKET_STATES);
+    uint8_t* out = db.mutableData();
+    std::fill(out, out + db.bytes(), uint8_t(0));
+    for (uint64_t idx = 0; idx < N_POCKET_STATES; ++idx)
+        out[idx >> 2] |= uint8_t((depth[idx] % 3) << (2 * (idx & 3)));
+}
+
+bool initPocketTable()
+{
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+    if (g_pocketTable.isReady()) return true;
+
+    const std::string path = pdbOptions().directory + "/pocket.pdb";
+    if (g_pocketTable.load(path, PDB_KIND_POCKET, N_POCKET_STATES)) return true;
+
+    auto t0 = std::chrono::steady_clock::now();
+    buildPocketTable(g_pocketTable);
+    std::clog << "2x2 distance table built in "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() << " ms\n";
+    if (!g_pocketTable.save(path, PDB_KIND_POCKET))
+    {
+        std::clog << "Could not write " << path << ", keeping table in memory only\n";
+        return true;
+    }
+    // switch to the mapped copy so the heap table is released
+    return g_pocketTable.load(path, PDB_KIND_POCKET, N_POCKET_STATES);
+}
+
+const PatternDatabase& pocketTable()
+{
+    return g_pocketTable;
+}
+
+// ----- Descent -----
+
+// From any state some neighbour is one closer, and its entry is the only
+// one of the nine reading (d - 1) mod 3: the others read d or d + 1.
+static vector<Move> descend(uint64_t idx)
+{
+    const PocketMoves& mv = pocketMoves();
+    vector<Move> path;
+    while (idx != 0)
+    {
+        const int closer = (g_pocketTable.get2(idx) + 2) % 3;
+        int m = 0;
+        while (m < POCKET_MOVES && g_pocketTable.get2(mv.next(idx, m)) != closer) ++m;
+        if (m == POCKET_MOVES || path.size() >= POCKET_MAX_DEPTH) return {}; // corrupt table
+        path.push_back(pocketMove(m));
+        idx = mv.next(idx, m);
+    }
+    return path;
+}
+
+int pocketDistance(const CubieCube& c)
+{
+    const int64_t idx = pocketIndex(c);
+    return idx < 0 ? -1 : int(descend(uint64_t(idx)).size());
+}
+
+vector<Move> solvePocket(const CubieCube& c)
+{
+    const int64_t idx = pocketIndex(c);
+    return idx < 0 ? vector<Move>() : descend(uint64_t(idx));
+}
+
+// ----- 2x2 Cubes -----
+
+namespace
+{
+    // 2x2 sticker at a corner position of the 3x3 layout
+    int pocketSticker(const StickerPos& p) { return p.f * 4 + (p.row / 2) * 2 + p.col / 2; }
+
+    // The 24 whole-cube turns as wide turns of both layers: each face
+    // brought to D, then four turns about the vertical.
+    vector<vector<LayerMove>> wholeCubeTurns()
+    {
+        const vector<LayerMove> toDown[6] = {
+            {}, { {Right, 0, 1, CW} }, { {Right, 0, 1, Double} }, { {Right, 0, 1, CCW} },
+            { {Front, 0, 1, CW} }, { {Front, 0, 1, CCW} },
+        };
+        vector<vector<LayerMove>> turns;
+        for (const vector<LayerMove>& base : toDown)
+            for (int k = 0; k < 4; ++k)
+            {
+                vector<LayerMove> seq = base;
+                if (k > 0) seq.push_back(LayerMove{Up, 0, 1, k == 1 ? CW : k == 2 ? Double : CCW});
+                turns.push_back(seq);
+            }
+        return turns;
+    }
+}
+
+vector<LayerMove> solvePocket(const NxNCube<2>& cube)
+{
+    if (cube.isSolved()) return {};
+
+    // which slot and sticker of the solved cube every 2x2 sticker is
+    static const auto home = [] {
+        array<std::pair<int, int>, 24> h{};
+        for (int j = 0; j < CubieCube::CORNERS; ++j)
+            for (int k = 0; k < 3; ++k) h[pocketSticker(kCornerSlots[j].sticker[k])] = { j, k };
+        return h;
+    }();
+    static const vector<vector<LayerMove>> turns = wholeCubeTurns();
+    const int dbl = pocketSticker(kCornerSlots[DBL].sticker[0]);
+
+    for (const vector<LayerMove>& turn : turns)
+    {
+        NxNCube<2> held = cube;
+        held.applyMoves(turn);
+        if (held.id(dbl) != dbl) continue;
+
+        // sticker k of slot i shows sticker (k - ori) of its cubie
+        CubieCube corners;
+        for (int i = 0; i < CubieCube::CORNERS; ++i)
+            for (int k = 0; k < 3; ++k)
+            {
+                const std::pair<int, int> h = home[held.id(pocketSticker(kCornerSlots[i].sticker[k]))];
+                if (h.second == 0) corners.setCorner(i, h.first, k);
+            }
+
+        const vector<Move> moves = solvePocket(corners);
+        if (moves.empty()) return {};
+
+        // a face of the held cube is the face of the cube that was turned
+        // onto it, so the solution needs no whole-cube turns
+        NxNCube<2> frame;
+        frame.applyMoves(turn);
+        vector<LayerMove> out;
+        for (const Move& m : moves)
+            out.push_back(LayerMove{Face(frame.id(m.face * 4) / 4), 0, 0, m.turn});
+        return out;
+    }
+    return {};
+}
+
+// ----- Self Check -----
+
+bool pocketSelfCheck(std::ostream& out)
+{
+    if (!initPocketTable()) { out << "2x2 table could not be built\n"; return false; }
+    const PocketMoves& mv = pocketMoves();
+
+    // states at each depth in the half-turn metric
+    static const uint64_t kKnown[POCKET_MAX_DEPTH + 1] = {
+        1, 9, 54, 321, 1847, 9992, 50136, 227536, 870072, 1887748, 623800, 2644 };
+    uint64_t counts[POCKET_MAX_DEPTH + 1] = {};
+    vector<uint64_t> layer = { 0 }, next;
+    vector<uint8_t> seen(N_POCKET_STATES, 0);
+    seen[0] = 1;
+    for (int d = 0; !layer.empty() && d <= POCKET_MAX_DEPTH; ++d)
+    {
+        counts[d] = layer.size();
+        next.clear();
+        for (uint64_t idx : layer)
+        {
+            if (g_pocketTable.get2(idx) != d % 3) { out << "2x2 table entry " << idx << " is not " << d << " mod 3\n"; return false; }
+            for (int m = 0; m < POCKET_MOVES; ++m)
+            {
+                const uint64_t n = mv.next(idx, m);
+                if (!seen[n]) { seen[n] = 1; next.push_back(n); }
+            }
+        }
+        layer.swap(next);
+    }
+    for (int d = 0; d <= POCKET_MAX_DEPTH; ++d)
+        if (counts[d] != kKnown[d]) { out << "2x2 has " << counts[d] << " states at depth " << d << ", expected " << kKnown[d] << "\n"; return false; }
+
+    std::mt19937 rng(2025);
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1), wideDist(0, 1);
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        NxNCube<2> cube;
+        for (int i = 0; i < 25; ++i)
+        {
+            const Move m = allMoves[moveDist(rng)];
+            cube.applyMove(LayerMove{m.face, 0, uint8_t(wideDist(rng)), m.turn});
+        }
+        const vector<LayerMove> sol = solvePocket(cube);
+        NxNCube<2> done = cube;
+        done.applyMoves(sol);
+        if (!done.isSolved() || sol.size() > POCKET_MAX_DEPTH) {
+            out << "2x2 descent did not solve a scramble in " << POCKET_MAX_DEPTH << " moves\n";
+            return false;
+        }
+    }
+
+    // the corner table holds exact distances, which agree with this one
+    // wherever DBL is home; skipped unless it was built already
+    PatternDatabase corners;
+    int compared = 0;
+    if (corners.load(pdbOptions().directory + "/corners.pdb", PDB_KIND_CORNERS, N_CORNER_STATES))
+    {
+        initCoordTables();
+        std::uniform_int_distribution<int> pocketDist(0, POCKET_MOVES - 1);
+        for (; compared < 2000; ++compared)
+        {
+            CubieCube c;
+            const int len = compared % 16;
+            for (int i = 0; i < len; ++i) { const Move m = pocketMove(pocketDist(rng)); c.applyMove(m.face, m.turn); }
+            if (corners.get(cornerIndex(CoordCube(c))) != pocketDistance(c)) {
+                out << "corners.pdb disagrees with the 2x2 table\n";
+                return false;
+            }
+        }
+    }
+
+    out << "2x2 table self-check passed (" << N_POCKET_STATES << " states, "
+        << g_pocketTable.bytes() << " bytes";
+    if (compared > 0) out << ", " << compared << " corner table entries";
+    out << ")\n";
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef POCKET_HPP
+#define POCKET_HPP
+
+#include "nxncube.hpp"
+#include "pdb.hpp"
+#include <iosfwd>
+
+///// POCKET CUBE /////
+
+// The 2x2 is the eight corners of the 3x3 (kCornerSlots) with nothing to
+// fix the frame, so it is held by its DBL corner: U, R and F never move
+// that corner and reach every state, 7! * 3^6 of them. The whole table of
+// distances fits in 2 bits per state (under 1 MB) because neighbouring
+// states differ by at most one: a state's distance mod 3 is enough to tell
+// which neighbour is one closer, so an optimal solution is read off by
+// walking down the table with no search.
+
+static constexpr int      N_POCKET_PERM   = 5040; // 7!, slot 6 (DBL) held
+static constexpr int      N_POCKET_TWIST  = 729;  // 3^6, slot 7 implied
+static constexpr uint64_t N_POCKET_STATES = uint64_t(N_POCKET_PERM) * N_POCKET_TWIST;
+static constexpr uint32_t PDB_KIND_POCKET = 3;
+static constexpr int      POCKET_MAX_DEPTH = 11; // God's number, half turns
+
+// index of the corners, -1 unless the DBL corner is home and untwisted
+int64_t pocketIndex(const CubieCube& c);
+
+// maps pocket.pdb, building and saving it first if needed
+bool initPocketTable();
+const PatternDatabase& pocketTable();
+
+// exact half-turn distance and an optimal U, R, F solution of the corners
+// (the table must be ready); -1 and empty when DBL is not home
+int pocketDistance(const CubieCube& c);
+vector<Move> solvePocket(const CubieCube& c);
+
+// Any 2x2: the corners are read with DBL turned home, and the solution is
+// written back in the cube's own frame, so it is optimal over all six faces.
+vector<LayerMove> solvePocket(const NxNCube<2>& cube);
+
+// depth histogram against the known one, descents against table distances,
+// random 2x2s, and corners.pdb against the table when that file is there
+bool pocketSelfCheck(std::ostream& out);
+
+#endif // POCKET_HPP
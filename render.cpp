@@ -0,0 +1,82 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "softrender.hpp"
+#include "solver.hpp"
+
+// rubik-render: renders a scramble and its solution as numbered image
+// frames on the CPU, for replay videos on machines without a GPU. Without
+// --solution the two-phase solver finds one.
+
+static void usage()
+{
+    std::cerr <<
+        "usage: rubik-render --scramble \"R U F'\" [options]\n"
+        "  --solution MOVES        play these moves after the scramble (default: solve it)\n"
+        "  --size WxH              frame size in pixels (default 640x480)\n"
+        "  --fps N                 frames per second (default 30)\n"
+        "  --move-ms MS            time per face turn (default 300)\n"
+        "  --ssaa N                N x N samples per pixel (default 1)\n"
+        "  --format png|ppm        frame file type (default png)\n"
+        "  --out DIR               where frame_00000.png and on are written (default .)\n"
+        "  --threads N             frames rendered in parallel (default all cores)\n";
+}
+
+int main(int argc, char** argv)
+{
+    ReplayOptions options;
+    std::string scrambleText, solutionText;
+    bool haveSolution = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") { usage(); return 0; }
+        if (i + 1 >= argc) { usage(); return 2; }
+        std::string val = argv[++i];
+
+        // a value that is not a number, or out of range, is a usage error
+        try {
+            if (arg == "--scramble") scrambleText = val;
+            else if (arg == "--solution") { solutionText = val; haveSolution = true; }
+            else if (arg == "--size") {
+                size_t x = val.find('x');
+                if (x == std::string::npos) { usage(); return 2; }
+                options.view.width = std::stoi(val.substr(0, x));
+                options.view.height = std::stoi(val.substr(x + 1));
+            }
+            else if (arg == "--fps")     options.fps = std::stoi(val);
+            else if (arg == "--move-ms") options.moveSeconds = std::stof(val) * 0.001f;
+            else if (arg == "--ssaa")    options.view.supersample = std::stoi(val);
+            else if (arg == "--format")  options.format = val;
+            else if (arg == "--out")     options.directory = val;
+            else if (arg == "--threads") options.threads = std::stoi(val);
+            else { usage(); return 2; }
+        } catch (const std::logic_error&) { usage(); return 2; }
+    }
+    if (options.view.width <= 0 || options.view.height <= 0 || options.fps <= 0 || options.moveSeconds <= 0 ||
+        options.view.supersample < 1 || options.threads < 0 ||
+        (options.format != "png" && options.format != "ppm")) { usage(); return 2; }
+
+    vector<Move> scramble, solution;
+    if (!parseMoves(scrambleText, scramble)) { std::cerr << "could not read scramble: " << scrambleText << "\n"; return 2; }
+    if (haveSolution && !parseMoves(solutionText, solution)) {
+        std::cerr << "could not read solution: " << solutionText << "\n";
+        return 2;
+    }
+    if (!haveSolution)
+    {
+        RubiksCube cube;
+        cube.applyMoves(scramble);
+        TwoPhaseSolver solver;
+        solution = solver.solve(cube);
+        if (solution.empty() && !cube.isSolved()) { std::cerr << "no solution found\n"; return 1; }
+        std::clog << "solution: " << movesToString(solution) << "\n";
+    }
+
+    ReplayStats stats = renderReplay(scramble, solution, options);
+    std::clog << stats.frames << " frames (" << scramble.size() << " + " << solution.size() << " moves) in "
+              << stats.ms << " ms to " << options.directory << "\n";
+    if (stats.failed > 0) { std::clog << stats.failed << " frames could not be written\n"; return 1; }
+    return 0;
+}
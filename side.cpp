@@ -2,8 +2,9 @@
 
 ///// FACE ROTATIONS /////
 
-// rotate the 3x3 face 90° clockwise
-void Side::rotateCW()
+// rotate the face 90° clockwise
+template <int N>
+void SideN<N>::rotateCW()
 {
     array<array<Color, SIZE>, SIZE> tmp = squares;
 
@@ -17,7 +18,8 @@ void Side::rotateCW()
 }
 
 // rotate 90° counter-clockwise
-void Side::rotateCCW()
+template <int N>
+void SideN<N>::rotateCCW()
 {
     array<array<Color, SIZE>, SIZE> tmp = squares;
 
@@ -31,8 +33,16 @@ void Side::rotateCCW()
 }
 
 // rotate 180°
-void Side::rotate180()
+template <int N>
+void SideN<N>::rotate180()
 {
     rotateCW();
     rotateCW();
 }
+
+template struct SideN<2>;
+template struct SideN<3>;
+template struct SideN<4>;
+template struct SideN<5>;
+template struct SideN<6>;
+template struct SideN<7>;
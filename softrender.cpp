@@ -0,0 +1,325 @@
+#include "softrender.hpp"
+#include "threadpool.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <ostream>
+
+// ----- Rasterizer -----
+
+namespace {
+
+struct Vec3 { float x, y, z; };
+
+// counterclockwise by degrees around a unit axis, as glRotatef
+Vec3 rotate(const Vec3& v, float degrees, const Vec3& axis)
+{
+    const float a = degrees * 3.14159265358979f / 180.0f;
+    const float c = std::cos(a), s = std::sin(a);
+    const float d = axis.x * v.x + axis.y * v.y + axis.z * v.z;
+    const Vec3 cross = { axis.y * v.z - axis.z * v.y, axis.z * v.x - axis.x * v.z, axis.x * v.y - axis.y * v.x };
+    return { v.x * c + cross.x * s + axis.x * d * (1 - c),
+             v.y * c + cross.y * s + axis.y * d * (1 - c),
+             v.z * c + cross.z * s + axis.z * d * (1 - c) };
+}
+
+// window position and 1/depth, which is linear across the screen
+struct ScreenVertex { float x, y, invDepth; };
+
+struct Target
+{
+    int width, height;
+    uint8_t* rgb;
+    float* invDepth; // 0 = nothing drawn yet
+};
+
+void fillTriangle(const Target& t, const ScreenVertex& a, const ScreenVertex& b, const ScreenVertex& c,
+                  const uint8_t rgb[3])
+{
+    const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::fabs(area) < 1e-12f) return;
+    const float inv = 1.0f / area;
+
+    const int x0 = std::max(0, int(std::floor(std::min({a.x, b.x, c.x}))));
+    const int x1 = std::min(t.width - 1, int(std::ceil(std::max({a.x, b.x, c.x}))));
+    const int y0 = std::max(0, int(std::floor(std::min({a.y, b.y, c.y}))));
+    const int y1 = std::min(t.height - 1, int(std::ceil(std::max({a.y, b.y, c.y}))));
+
+    // barycentric weights are linear in x, so step them along each row
+    const float dWa = -(c.y - b.y) * inv, dWb = -(a.y - c.y) * inv;
+    for (int y = y0; y <= y1; ++y)
+    {
+        const float py = y + 0.5f, px = x0 + 0.5f;
+        // all >= 0 inside whichever way the triangle winds
+        float wa = ((b.x - px) * (c.y - py) - (b.y - py) * (c.x - px)) * inv;
+        float wb = ((c.x - px) * (a.y - py) - (c.y - py) * (a.x - px)) * inv;
+        size_t i = size_t(y) * t.width + x0;
+        for (int x = x0; x <= x1; ++x, ++i, wa += dWa, wb += dWb)
+        {
+            const float wc = 1.0f - wa - wb;
+            if (wa < 0 || wb < 0 || wc < 0) continue;
+
+            const float z = wa * a.invDepth + wb * b.invDepth + wc * c.invDepth;
+            if (z <= t.invDepth[i]) continue;
+            t.invDepth[i] = z;
+            t.rgb[i * 3 + 0] = rgb[0];
+            t.rgb[i * 3 + 1] = rgb[1];
+            t.rgb[i * 3 + 2] = rgb[2];
+        }
+    }
+}
+
+} // namespace
+
+void renderCube(const RubiksCube& cube, bool isAnimating, const Move& animMove, float animProgress,
+                float animDuration, const RenderView& view, Image& out)
+{
+    const int ss = std::max(1, view.supersample);
+    const int w = view.width * ss, h = view.height * ss;
+
+    // per thread, so a replay worker reuses its buffers frame after frame
+    thread_local vector<uint8_t> rgb;
+    thread_local vector<float> depth;
+    rgb.resize(size_t(w) * h * 3);
+    depth.assign(size_t(w) * h, 0.0f);
+    for (size_t i = 0; i < size_t(w) * h; ++i)
+        for (int k = 0; k < 3; ++k) rgb[i * 3 + k] = view.background[k];
+
+    float angle = 0.0f;
+    const bool hasAngle = calculateAnimAngle(isAnimating, animMove, animProgress, animDuration, angle);
+    Vec3 axis{0, 0, 0};
+    if (hasAngle) axisForFace(animMove.face, axis.x, axis.y, axis.z);
+    const uint8_t layerBit = hasAngle ? uint8_t(1u << animMove.face) : 0;
+
+    const float f = 1.0f / std::tan(view.fovY * 3.14159265358979f / 360.0f);
+    const float aspect = float(view.width) / float(view.height);
+    const Vec3 xAxis{1, 0, 0}, yAxis{0, 1, 0};
+
+    // the visualizer's modelview: translate(0,0,-dist) * rotX * rotY, with
+    // the turning layer's rotation innermost
+    const CubeMesh& mesh = cubeMesh();
+    auto project = [&](int v) {
+        Vec3 p{ mesh.positions[v * 3], mesh.positions[v * 3 + 1], mesh.positions[v * 3 + 2] };
+        if (mesh.layers[v] & layerBit) p = rotate(p, angle, axis);
+        p = rotate(rotate(p, view.camAngleY, yAxis), view.camAngleX, xAxis);
+        const float depthAway = view.camDist - p.z; // positive in front of the camera
+        return ScreenVertex{ (f / aspect * p.x / depthAway + 1.0f) * 0.5f * w,
+                             (1.0f - f * p.y / depthAway) * 0.5f * h,
+                             1.0f / depthAway };
+    };
+
+    const Target target{ w, h, rgb.data(), depth.data() };
+    const uint8_t black[3] = {0, 0, 0};
+    for (int q = 0; q < mesh.vertexCount; q += 4)
+    {
+        uint8_t color[4] = {0, 0, 0, 255};
+        if (q >= mesh.stickerBase)
+        {
+            const int s = (q - mesh.stickerBase) / 4;
+            stickerRGBA(cube.sticker(Face(s / 9), (s % 9) / 3, s % 3), color);
+        }
+        const ScreenVertex v0 = project(q), v1 = project(q + 1), v2 = project(q + 2), v3 = project(q + 3);
+        const uint8_t* c = q >= mesh.stickerBase ? color : black;
+        fillTriangle(target, v0, v1, v2, c);
+        fillTriangle(target, v0, v2, v3, c);
+    }
+
+    // box filter down to the requested size
+    out.width = view.width;
+    out.height = view.height;
+    if (ss == 1) { out.rgb.assign(rgb.begin(), rgb.end()); return; }
+    out.rgb.resize(size_t(view.width) * view.height * 3);
+    const int samples = ss * ss;
+    for (int y = 0; y < view.height; ++y)
+        for (int x = 0; x < view.width; ++x)
+            for (int k = 0; k < 3; ++k)
+            {
+                int sum = 0;
+                for (int sy = 0; sy < ss; ++sy)
+                    for (int sx = 0; sx < ss; ++sx)
+                        sum += rgb[((size_t(y) * ss + sy) * w + size_t(x) * ss + sx) * 3 + k];
+                out.rgb[(size_t(y) * view.width + x) * 3 + k] = uint8_t((sum + samples / 2) / samples);
+            }
+}
+
+// ----- Image Files -----
+
+bool writePPM(const std::string& path, const Image& image)
+{
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fprintf(f, "P6\n%d %d\n255\n", image.width, image.height) > 0 &&
+              std::fwrite(image.rgb.data(), 1, image.rgb.size(), f) == image.rgb.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+static uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+{
+    static const auto table = [] {
+        array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void putBE32(vector<uint8_t>& out, uint32_t v)
+{
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(uint8_t(v >> shift));
+}
+
+static void appendChunk(vector<uint8_t>& file, const char type[4], const vector<uint8_t>& data)
+{
+    putBE32(file, uint32_t(data.size()));
+    const size_t start = file.size();
+    file.insert(file.end(), type, type + 4);
+    file.insert(file.end(), data.begin(), data.end());
+    putBE32(file, crc32(&file[start], file.size() - start));
+}
+
+bool writePNG(const std::string& path, const Image& image)
+{
+    // each row behind a "no filter" byte, in stored deflate blocks
+    const size_t rowBytes = size_t(image.width) * 3;
+    vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * image.height);
+    for (int y = 0; y < image.height; ++y)
+    {
+        raw.push_back(0);
+        raw.insert(raw.end(), image.rgb.begin() + y * rowBytes, image.rgb.begin() + (y + 1) * rowBytes);
+    }
+
+    vector<uint8_t> z = { 0x78, 0x01 };
+    for (size_t pos = 0; pos < raw.size() || pos == 0; )
+    {
+        const size_t n = std::min<size_t>(65535, raw.size() - pos);
+        const bool last = pos + n == raw.size();
+        z.push_back(last ? 1 : 0);
+        z.push_back(uint8_t(n)); z.push_back(uint8_t(n >> 8));
+        z.push_back(uint8_t(~n)); z.push_back(uint8_t(~n >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+        if (last) break;
+    }
+    // adler-32, reduced once per 5552 bytes as zlib does, before s2 can overflow
+    uint32_t s1 = 1, s2 = 0;
+    for (size_t pos = 0; pos < raw.size(); pos += 5552)
+    {
+        const size_t end = std::min(raw.size(), pos + 5552);
+        for (size_t i = pos; i < end; ++i) { s1 += raw[i]; s2 += s1; }
+        s1 %= 65521; s2 %= 65521;
+    }
+    putBE32(z, (s2 << 16) | s1);
+
+    vector<uint8_t> header;
+    putBE32(header, uint32_t(image.width));
+    putBE32(header, uint32_t(image.height));
+    header.insert(header.end(), { 8, 2, 0, 0, 0 }); // 8-bit RGB, no interlace
+
+    vector<uint8_t> file = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    appendChunk(file, "IHDR", header);
+    appendChunk(file, "IDAT", z);
+    appendChunk(file, "IEND", {});
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(file.data(), 1, file.size(), f) == file.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+// ----- Replays -----
+
+int replayFrameCount(size_t moves, const ReplayOptions& options)
+{
+    return int(std::ceil(moves * options.moveSeconds * options.fps - 1e-4)) + 1;
+}
+
+ReplayStats renderReplay(const vector<Move>& scramble, const vector<Move>& solution, const ReplayOptions& options)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point t0 = Clock::now();
+
+    vector<Move> moves = scramble;
+    moves.insert(moves.end(), solution.begin(), solution.end());
+
+    // the cube before each move, and after the last one
+    vector<RubiksCube> states(moves.size() + 1);
+    for (size_t i = 0; i < moves.size(); ++i)
+    {
+        states[i + 1] = states[i];
+        states[i + 1].applyMove(moveIndex(moves[i]));
+    }
+
+    ReplayStats stats;
+    stats.frames = replayFrameCount(moves.size(), options);
+    std::error_code ec;
+    std::filesystem::create_directories(options.directory, ec);
+
+    const bool png = options.format != "ppm";
+    std::atomic<int> failed{0};
+    WorkStealingPool pool(options.threads > 0 ? options.threads : int(std::thread::hardware_concurrency()));
+    pool.run(stats.frames, [&](int frame) {
+        const double t = double(frame) / options.fps;
+        size_t k = size_t(t / options.moveSeconds);
+        float progress = float(t - k * double(options.moveSeconds));
+        if (k >= moves.size()) { k = moves.size(); progress = 0.0f; }
+
+        Image image;
+        renderCube(states[k], k < moves.size(), k < moves.size() ? moves[k] : Move{},
+                   progress, options.moveSeconds, options.view, image);
+
+        char name[32];
+        std::snprintf(name, sizeof name, "frame_%05d.%s", frame, png ? "png" : "ppm");
+        const std::string path = (std::filesystem::path(options.directory) / name).string();
+        if (!(png ? writePNG(path, image) : writePPM(path, image))) failed.fetch_add(1);
+    });
+
+    stats.failed = failed.load();
+    stats.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return stats;
+}
+
+// ----- Self Check -----
+
+bool softRenderSelfCheck(std::ostream& out)
+{
+    RenderView view;
+    view.width = view.height = 96;
+    vector<Move> scramble;
+    parseMoves("R U2 F' L D B2", scramble);
+    RubiksCube start;
+    start.applyMoves(scramble);
+
+    // a turn drawn at its end must look like the cube after it, up to
+    // rounding along edges; this pins the angle signs and sticker mapping
+    bool ok = true;
+    for (int m = 0; m < MOVE_COUNT; ++m)
+    {
+        Image turned, after;
+        renderCube(start, true, allMoves[m], 1.0f, 1.0f, view, turned);
+        RubiksCube next = start;
+        next.applyMove(m);
+        renderCube(next, false, Move{}, 0.0f, 1.0f, view, after);
+
+        int differing = 0;
+        for (size_t i = 0; i < turned.rgb.size(); i += 3)
+            if (std::abs(turned.rgb[i] - after.rgb[i]) + std::abs(turned.rgb[i + 1] - after.rgb[i + 1]) +
+                std::abs(turned.rgb[i + 2] - after.rgb[i + 2]) > 24) ++differing;
+        if (differing > view.width * view.height / 100)
+        {
+            out << "software render: " << moveToString(allMoves[m]) << " at the end of its turn differs from the cube after it in "
+                << differing << " pixels\n";
+            ok = false;
+        }
+    }
+    if (ok) out << "software render self-check passed (" << MOVE_COUNT << " moves)\n";
+    return ok;
+}
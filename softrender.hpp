@@ -0,0 +1,72 @@
+#ifndef SOFTRENDER_HPP
+#define SOFTRENDER_HPP
+
+#include "cubegeometry.hpp"
+#include <iosfwd>
+#include <string>
+
+///// SOFTWARE RENDERER /////
+
+// Draws cubeMesh() on the CPU into an RGB image, with the visualizer's
+// camera and turn animation, for machines without a GPU or display. Quads
+// are split into triangles and filled with a depth test; flat colours, no
+// lighting, optional supersampling against jagged edges.
+
+struct RenderView
+{
+    int width  = 640;
+    int height = 480;
+    float camAngleX = 30.0f;  // as the visualizer opens
+    float camAngleY = -30.0f;
+    float camDist   = 6.0f;
+    float fovY      = 45.0f;
+    int supersample = 1;      // samples per pixel along each axis
+    uint8_t background[3] = {38, 38, 46};
+};
+
+struct Image
+{
+    int width = 0, height = 0;
+    vector<uint8_t> rgb; // rows from the top, 3 bytes per pixel
+};
+
+// same arguments as CubeRenderer::draw, plus where to look from
+void renderCube(const RubiksCube& cube, bool isAnimating, const Move& animMove, float animProgress,
+                float animDuration, const RenderView& view, Image& out);
+
+bool writePPM(const std::string& path, const Image& image);
+bool writePNG(const std::string& path, const Image& image); // uncompressed deflate, no zlib needed
+
+///// SOLUTION REPLAYS /////
+
+// Frame i shows time i / fps of the scramble played from solved and then
+// the solution, each move taking moveSeconds; the last frame holds the end
+// state. Frames only depend on the state before their move, so they are
+// rendered and written in parallel.
+struct ReplayOptions
+{
+    RenderView view;
+    int fps = 30;
+    float moveSeconds = 0.30f;   // as the visualizer animates a turn
+    int threads = 0;             // 0 = hardware concurrency
+    std::string directory = ".";
+    std::string format = "png";  // or "ppm"
+};
+
+struct ReplayStats
+{
+    int frames = 0;
+    int failed = 0; // frames that could not be written
+    double ms = 0.0;
+};
+
+int replayFrameCount(size_t moves, const ReplayOptions& options);
+
+// writes directory/frame_00000.png and on
+ReplayStats renderReplay(const vector<Move>& scramble, const vector<Move>& solution, const ReplayOptions& options);
+
+// renders every move at the end of its turn against the cube after it;
+// prints failures to out
+bool softRenderSelfCheck(std::ostream& out);
+
+#endif // SOFTRENDER_HPP
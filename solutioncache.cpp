@@ -0,0 +1,228 @@
+#include "solutioncache.hpp"
+#include "symmetry.hpp"
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+// ----- File Format -----
+
+struct CacheHeader
+{
+    char     magic[8]; // "RUBIKSLC"
+    uint32_t version;
+    uint32_t count;
+};
+
+static const char kCacheMagic[8] = { 'R','U','B','I','K','S','L','C' };
+
+// ----- Keys -----
+
+SolutionCache::Key SolutionCache::keyOf(const CubieCube& canonical)
+{
+    Key k{0, 0};
+    for (int i = 0; i < CubieCube::CORNERS; ++i) k.corners |= uint64_t(canonical.corners[i]) << (5 * i);
+    for (int i = 0; i < CubieCube::EDGES; ++i)   k.edges   |= uint64_t(canonical.edges[i]) << (5 * i);
+    return k;
+}
+
+size_t SolutionCache::KeyHash::operator()(const Key& k) const
+{
+    uint64_t z = k.corners * 0x9E3779B97F4A7C15ull ^ k.edges;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return size_t(z ^ (z >> 31));
+}
+
+// ----- Lookup and Insert -----
+
+SolutionCache::SolutionCache(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+bool SolutionCache::lookup(const RubiksCube& cube, vector<Move>& solution)
+{
+    int sym = 0;
+    const Key key = keyOf(canonicalCube(CubieCube(cube), N_SYM, &sym));
+
+    std::lock_guard<std::mutex> guard(lock_);
+    ++metrics_.lookups;
+    auto it = index_.find(key);
+    if (it == index_.end()) return false;
+
+    ++metrics_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+
+    // the stored moves solve conjugate(cube, sym); carry them back
+    const int back = inverseSymmetry(sym);
+    solution.clear();
+    for (uint8_t m : it->second->moves) solution.push_back(allMoves[conjugateMove(back, m)]);
+    return true;
+}
+
+void SolutionCache::insert(const RubiksCube& cube, const vector<Move>& solution)
+{
+    if (solution.empty()) return;
+
+    int sym = 0;
+    const Key key = keyOf(canonicalCube(CubieCube(cube), N_SYM, &sym));
+    vector<uint8_t> moves;
+    moves.reserve(solution.size());
+    for (const Move& m : solution) moves.push_back(uint8_t(conjugateMove(sym, moveIndex(m))));
+
+    std::lock_guard<std::mutex> guard(lock_);
+    ++metrics_.inserts;
+    insertLocked(key, std::move(moves));
+}
+
+void SolutionCache::insertLocked(const Key& key, vector<uint8_t> moves)
+{
+    auto it = index_.find(key);
+    if (it != index_.end())
+    {
+        it->second->moves = std::move(moves);
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+    if (entries_.size() >= capacity_)
+    {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+        ++metrics_.evictions;
+    }
+    entries_.push_front({key, std::move(moves)});
+    index_.emplace(key, entries_.begin());
+}
+
+size_t SolutionCache::size() const
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    return entries_.size();
+}
+
+SolutionCache::Metrics SolutionCache::metrics() const
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    return metrics_;
+}
+
+std::string SolutionCache::summary() const
+{
+    const Metrics m = metrics();
+    std::ostringstream out;
+    out << "solution cache: " << size() << "/" << capacity_ << " entries, " << m.hits << " hits in "
+        << m.lookups << " lookups (" << 100.0 * m.hitRate() << "%), " << m.evictions << " evicted";
+    return out.str();
+}
+
+// ----- Files -----
+
+bool SolutionCache::save(const std::string& path) const
+{
+    std::lock_guard<std::mutex> guard(lock_);
+
+    CacheHeader hdr{};
+    std::memcpy(hdr.magic, kCacheMagic, sizeof(hdr.magic));
+    hdr.version = VERSION;
+    hdr.count   = uint32_t(entries_.size());
+
+    // write beside the target and rename, so a crash never leaves half a file
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    for (const Entry& e : entries_)
+    {
+        if (!ok) break;
+        const uint8_t length = uint8_t(e.moves.size());
+        ok = std::fwrite(&e.key.corners, sizeof(uint64_t), 1, f) == 1 &&
+             std::fwrite(&e.key.edges, sizeof(uint64_t), 1, f) == 1 &&
+             std::fwrite(&length, 1, 1, f) == 1 &&
+             std::fwrite(e.moves.data(), 1, length, f) == length;
+    }
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) { std::remove(tmp.c_str()); return false; }
+
+    std::remove(path.c_str());
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool SolutionCache::load(const std::string& path)
+{
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    CacheHeader hdr{};
+    bool ok = std::fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+              std::memcmp(hdr.magic, kCacheMagic, sizeof(hdr.magic)) == 0 && hdr.version == VERSION;
+
+    // read everything first so a damaged file leaves the cache untouched
+    vector<Entry> loaded;
+    for (uint32_t i = 0; ok && i < hdr.count; ++i)
+    {
+        Entry e;
+        uint8_t length = 0;
+        ok = std::fread(&e.key.corners, sizeof(uint64_t), 1, f) == 1 &&
+             std::fread(&e.key.edges, sizeof(uint64_t), 1, f) == 1 &&
+             std::fread(&length, 1, 1, f) == 1 && length > 0;
+        if (!ok) break;
+        e.moves.resize(length);
+        ok = std::fread(e.moves.data(), 1, length, f) == length;
+        for (uint8_t m : e.moves) ok = ok && m < MOVE_COUNT;
+        if (ok) loaded.push_back(std::move(e));
+    }
+    std::fclose(f);
+    if (!ok) return false;
+
+    // oldest first, so the file's front ends up most recently used
+    std::lock_guard<std::mutex> guard(lock_);
+    const size_t keep = std::min(loaded.size(), capacity_);
+    for (size_t i = keep; i-- > 0; ) insertLocked(loaded[i].key, std::move(loaded[i].moves));
+    return true;
+}
+
+// ----- Self-Check -----
+
+bool solutionCacheSelfCheck(std::ostream& out)
+{
+    std::mt19937 rng(77);
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1);
+
+    SolutionCache cache(16);
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        // a scramble's inverse is a solution, optimal or not does not matter here
+        CubieCube c;
+        vector<Move> solution;
+        for (int i = 0; i < 12; ++i)
+        {
+            const int m = moveDist(rng);
+            c.applyMove(m);
+            solution.insert(solution.begin(), inverseOf(allMoves[m]));
+        }
+        if (c.isSolved()) continue;
+        cache.insert(c.toStickers(), solution);
+
+        for (int s = 0; s < N_SYM; ++s)
+        {
+            const CubieCube variant = conjugate(c, s);
+            vector<Move> found;
+            if (!cache.lookup(variant.toStickers(), found))
+            {
+                out << "solution cache misses a symmetric variant (symmetry " << s << ")\n";
+                return false;
+            }
+            CubieCube check = variant;
+            for (const Move& m : found) check.applyMove(moveIndex(m));
+            if (!check.isSolved() || found.size() != solution.size())
+            {
+                out << "solution cache returns a wrong solution for symmetry " << s << "\n";
+                return false;
+            }
+        }
+    }
+    if (cache.size() != cache.capacity() || cache.metrics().evictions == 0)
+    {
+        out << "solution cache does not evict at capacity\n";
+        return false;
+    }
+    out << "solution cache self-check passed\n";
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef SOLUTIONCACHE_HPP
+#define SOLUTIONCACHE_HPP
+
+#include "solver.hpp"
+#include "cubie.hpp"
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+///// SOLUTION CACHE /////
+
+// LRU map from cube states to optimal solutions, shared between threads.
+// States are keyed by their canonical form under all 48 symmetries, so a
+// position, its rotations, its mirror images and its recolourings share one
+// entry; a hit is turned back into moves for the cube that was asked about.
+// The cache can be saved to and loaded from a file for warm starts.
+class SolutionCache
+{
+public:
+    struct Metrics
+    {
+        long long lookups = 0, hits = 0, inserts = 0, evictions = 0;
+        double hitRate() const { return lookups > 0 ? double(hits) / lookups : 0.0; }
+    };
+
+    explicit SolutionCache(size_t capacity);
+
+    // true with the cube's solution in solution on a hit
+    bool lookup(const RubiksCube& cube, vector<Move>& solution);
+    // records an optimal solution; a solved cube or an empty result is ignored
+    void insert(const RubiksCube& cube, const vector<Move>& solution);
+
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    Metrics metrics() const;
+    std::string summary() const; // one line of size and hit rate
+
+    // most recently used first; load keeps that order and stops at capacity.
+    // Both return false on a missing, foreign or damaged file
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    static constexpr uint32_t VERSION = 1;
+
+    // a canonical CubieCube, five bits per piece
+    struct Key
+    {
+        uint64_t corners, edges;
+        bool operator==(const Key& o) const { return corners == o.corners && edges == o.edges; }
+    };
+    struct KeyHash { size_t operator()(const Key& k) const; };
+
+    struct Entry
+    {
+        Key key;
+        vector<uint8_t> moves; // solution of the canonical state
+    };
+
+    static Key keyOf(const CubieCube& canonical);
+    void insertLocked(const Key& key, vector<uint8_t> moves);
+
+    size_t capacity_;
+    mutable std::mutex lock_;
+    std::list<Entry> entries_; // front is the most recently used
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    Metrics metrics_;
+};
+
+// Consults the cache before running the wrapped solver and stores what it
+// finds. Only wrap optimal solvers: the cache promises optimal sequences.
+class CachedSolver : public Solver
+{
+public:
+    CachedSolver(std::unique_ptr<Solver> inner, SolutionCache& cache)
+        : inner_(std::move(inner)), cache_(cache) {}
+
+    const char* name() const override { return inner_->name(); }
+
+    vector<Move> solve(const RubiksCube& cube) override
+    {
+        vector<Move> solution;
+        if (cache_.lookup(cube, solution)) return solution;
+        inner_->setProgress(progress_);
+        solution = inner_->solve(cube);
+        cache_.insert(cube, solution);
+        return solution;
+    }
+
+    const Solver& inner() const { return *inner_; }
+
+private:
+    std::unique_ptr<Solver> inner_;
+    SolutionCache& cache_;
+};
+
+// stores solutions for random cubes and looks up every symmetric variant,
+// checking the returned moves solve it; prints failures to out
+bool solutionCacheSelfCheck(std::ostream& out);
+
+#endif // SOLUTIONCACHE_HPP
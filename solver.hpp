@@ -0,0 +1,180 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include "cube.hpp"
+#include "transposition.hpp"
+#include <chrono>
+#include <future>
+#include <thread>
+
+///// SOLVER INTERFACE /////
+
+// common front for every search engine, so callers can swap them freely
+class Solver
+{
+public:
+    virtual ~Solver() = default;
+
+    virtual const char* name() const = 0;
+
+    // empty result: already solved, or nothing found within the solver's limits
+    virtual vector<Move> solve(const RubiksCube& cube) = 0;
+
+    // later solves publish to progress and stop early once it is cancelled
+    void setProgress(SearchProgress* progress) { progress_ = progress; }
+
+protected:
+    SearchProgress* progress_ = nullptr;
+};
+
+// optimal IDA* over all 18 moves; a transpositionBytes budget in the options
+// gives a single-threaded solver one table that is reused across its solves,
+// while the root split divides the budget among its workers on every solve
+class IDAStarSolver : public Solver
+{
+public:
+    explicit IDAStarSolver(int maxIterations = -1, int iterationDepth = 20,
+                           const SearchOptions& options = SearchOptions())
+        : maxIterations_(maxIterations), iterationDepth_(iterationDepth), options_(options)
+    {
+        const int threads = options_.threads > 0 ? options_.threads : int(std::thread::hardware_concurrency());
+        if (!options_.transposition && options_.transpositionBytes > 0 && (threads <= 1 || iterationDepth_ < 2))
+        {
+            table_ = std::make_unique<TranspositionTable>(options_.transpositionBytes);
+            options_.transposition = table_.get();
+        }
+    }
+
+    const char* name() const override { return "IDA*"; }
+
+    vector<Move> solve(const RubiksCube& cube) override
+    {
+        SearchOptions options = options_;
+        options.stats = &stats_;
+        options.progress = progress_;
+        return cube.solveIDAStar(maxIterations_, iterationDepth_, options);
+    }
+
+    // counts from the last solve; only the outcome is filled without RUBIK_SEARCH_STATS
+    const SearchStats& lastStats() const { return stats_; }
+
+private:
+    int maxIterations_;
+    int iterationDepth_;
+    SearchOptions options_;
+    SearchStats stats_;
+    std::unique_ptr<TranspositionTable> table_;
+};
+
+// Kociemba two-phase: phase 1 reaches <U,D,R2,L2,F2,B2>, phase 2 solves
+// inside it. The first solution usually arrives within milliseconds and is
+// always waited for, however small the budget; the search then keeps
+// looking for shorter ones until the time budget runs out or a solution of
+// targetLength moves or fewer is found.
+class TwoPhaseSolver : public Solver
+{
+public:
+    explicit TwoPhaseSolver(int targetLength = 20, double timeBudgetMs = 1000.0,
+                            int maxLength = 30)
+        : targetLength_(targetLength), timeBudgetMs_(timeBudgetMs), maxLength_(maxLength) {}
+
+    const char* name() const override { return "Two-phase"; }
+
+    vector<Move> solve(const RubiksCube& cube) override;
+
+    // called with every improved solution as it is found
+    void setOnImproved(std::function<void(const vector<Move>&)> cb) { onImproved_ = std::move(cb); }
+
+private:
+    int targetLength_;
+    double timeBudgetMs_;
+    int maxLength_;
+    std::function<void(const vector<Move>&)> onImproved_;
+};
+
+// builds the two-phase move and pruning tables once
+void initTwoPhaseTables();
+
+// Optimal solver for short scrambles that searches from both ends. Every
+// state within frontierDepth() moves of solved is hashed once into a shared
+// table (the deepest layer that fits frontierBytes), then a bounded
+// depth-first search from the scramble looks for a state in it and joins
+// the two halves. A scramble of length L costs a search L - frontierDepth()
+// deep instead of L.
+class MeetInMiddleSolver : public Solver
+{
+public:
+    struct Stats
+    {
+        int       frontierDepth = 0;
+        long long frontierStates = 0;
+        long long forwardNodes = 0;
+        long long probes = 0;
+        double    ms = 0.0;
+    };
+
+    explicit MeetInMiddleSolver(int maxLength = 14, size_t frontierBytes = size_t(64) << 20,
+                                HeuristicKind heuristic = HeuristicCorners)
+        : maxLength_(maxLength), frontierBytes_(frontierBytes), heuristic_(heuristic) {}
+
+    const char* name() const override { return "Meet-in-the-middle"; }
+
+    vector<Move> solve(const RubiksCube& cube) override;
+
+    const Stats& lastStats() const { return stats_; }
+
+private:
+    int maxLength_;
+    size_t frontierBytes_;
+    HeuristicKind heuristic_;
+    Stats stats_;
+};
+
+// the frontier depth a byte budget buys, and building it ahead of the
+// first solve (solvers share one table per depth)
+int meetInMiddleDepth(size_t frontierBytes);
+void initMeetInMiddle(size_t frontierBytes);
+
+// Runs one solve on its own thread so a caller with an event loop never
+// blocks: poll ready(), read progress() in the meantime, cancel() to stop
+// early. The solver and a copy of the cube are owned for the duration.
+class AsyncSolve
+{
+public:
+    AsyncSolve(std::unique_ptr<Solver> solver, const RubiksCube& cube)
+        : solver_(std::move(solver)), cube_(cube)
+    {
+        solver_->setProgress(&progress_);
+        result_ = std::async(std::launch::async, [this] { return solver_->solve(cube_); });
+    }
+
+    // a dropped handle cancels its search and waits for it to wind down
+    ~AsyncSolve()
+    {
+        if (!result_.valid()) return;
+        cancel();
+        result_.wait();
+    }
+
+    AsyncSolve(const AsyncSolve&) = delete;
+    AsyncSolve& operator=(const AsyncSolve&) = delete;
+
+    bool ready() const { return result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+    void cancel() { progress_.cancel.store(true); }
+    bool cancelled() const { return progress_.cancel.load(); }
+
+    const SearchProgress& progress() const { return progress_; }
+    const Solver& solver() const { return *solver_; }
+    const RubiksCube& cube() const { return cube_; }
+
+    // the solution once ready(); call once
+    vector<Move> take() { return result_.get(); }
+
+private:
+    std::unique_ptr<Solver> solver_;
+    RubiksCube cube_;
+    SearchProgress progress_;
+    std::future<vector<Move>> result_;
+};
+
+#endif // SOLVER_HPP
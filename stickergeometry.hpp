@@ -0,0 +1,53 @@
+#ifndef STICKERGEOMETRY_HPP
+#define STICKERGEOMETRY_HPP
+
+#include "cube.hpp"
+
+///// STICKER GEOMETRY /////
+
+// Where each sticker of the flat array sits on the surface of a 3x3x3 cube
+// centred on the origin (x = R, y = U, z = F). The directions match the
+// sticker layout in kCornerSlots/kEdgeSlots. The sticker move tables and the
+// cube symmetries are both generated from these, so they cannot disagree.
+
+namespace stickergeo
+{
+    struct Vec3 { int x, y, z; };
+
+    constexpr int dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    constexpr Vec3 cross(const Vec3& a, const Vec3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    // outward normal of each face and the directions its rows and columns run
+    inline constexpr Vec3 kNormal[Face::Count] = { {0, 1, 0}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 0, 1}, {0, 0, -1} };
+    inline constexpr Vec3 kRowDir[Face::Count] = { {0, 0, 1}, {0, 0, -1}, {0, -1, 0}, {0, -1, 0}, {0, -1, 0}, {0, -1, 0} };
+    inline constexpr Vec3 kColDir[Face::Count] = { {1, 0, 0}, {1, 0, 0}, {0, 0, 1}, {0, 0, -1}, {1, 0, 0}, {-1, 0, 0} };
+
+    // the sticker's position, each coordinate in -1..1
+    constexpr Vec3 point(int sticker)
+    {
+        const int f = sticker / 9, dr = (sticker / 3) % 3 - 1, dc = sticker % 3 - 1;
+        const Vec3 &n = kNormal[f], &r = kRowDir[f], &c = kColDir[f];
+        return { n.x + dr * r.x + dc * c.x, n.y + dr * r.y + dc * c.y, n.z + dr * r.z + dc * c.z };
+    }
+
+    // Face::Count when normal is not a face's
+    constexpr Face faceOf(const Vec3& normal)
+    {
+        for (int f = 0; f < Face::Count; ++f)
+            if (dot(kNormal[f], normal) == 1) return Face(f);
+        return Face::Count;
+    }
+
+    // the sticker at position p facing out along normal
+    constexpr int stickerAt(const Vec3& p, const Vec3& normal)
+    {
+        const Face f = faceOf(normal);
+        const Vec3 rel = { p.x - normal.x, p.y - normal.y, p.z - normal.z };
+        return stickerIndex(f, 1 + dot(rel, kRowDir[f]), 1 + dot(rel, kColDir[f]));
+    }
+}
+
+#endif // STICKERGEOMETRY_HPP
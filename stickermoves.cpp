@@ -0,0 +1,340 @@
+#include "stickermoves.hpp"
+#include <bit>
+#include <ostream>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RUBIK_X86_SHUFFLE 1
+#include <immintrin.h>
+#else
+#define RUBIK_X86_SHUFFLE 0
+#endif
+
+// ----- Move Kernels -----
+
+// Touches only the 20 stickers that move: each 4-cycle is packed into a
+// word and rotated by one, two or three bytes.
+static void applyScalar(uint8_t* s, const Move* seq, size_t count)
+{
+    // bits each packed cycle rotates right by, indexed by Turn
+    static constexpr int kShift[3] = { 8, 24, 16 };
+    for (size_t i = 0; i < count; ++i)
+    {
+        const StickerCycles& cycles = kStickerCycles[seq[i].face];
+        const int shift = kShift[seq[i].turn];
+        for (int k = 0; k < STICKER_CYCLES; ++k)
+        {
+            const uint8_t* c = cycles.cycle[k];
+            uint32_t v = uint32_t(s[c[0]]) | uint32_t(s[c[1]]) << 8 | uint32_t(s[c[2]]) << 16 | uint32_t(s[c[3]]) << 24;
+            v = std::rotr(v, shift);
+            s[c[0]] = uint8_t(v);
+            s[c[1]] = uint8_t(v >> 8);
+            s[c[2]] = uint8_t(v >> 16);
+            s[c[3]] = uint8_t(v >> 24);
+        }
+    }
+}
+
+#if RUBIK_X86_SHUFFLE
+
+// four 16-byte registers, sixteen shuffles per move
+__attribute__((target("ssse3")))
+static void applySSSE3(uint8_t* s, const Move* seq, size_t count)
+{
+    __m128i chunk[STICKER_CHUNKS];
+    for (int k = 0; k < STICKER_CHUNKS; ++k) chunk[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(s) + k);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const StickerShuffle& sh = kStickerShuffles[moveIndex(seq[i])];
+        __m128i out[STICKER_CHUNKS];
+        for (int o = 0; o < STICKER_CHUNKS; ++o)
+        {
+            out[o] = _mm_shuffle_epi8(chunk[0], _mm_load_si128(reinterpret_cast<const __m128i*>(sh.mask[0][o])));
+            for (int k = 1; k < STICKER_CHUNKS; ++k)
+                out[o] = _mm_or_si128(out[o], _mm_shuffle_epi8(chunk[k], _mm_load_si128(reinterpret_cast<const __m128i*>(sh.mask[k][o]))));
+        }
+        for (int k = 0; k < STICKER_CHUNKS; ++k) chunk[k] = out[k];
+    }
+
+    for (int k = 0; k < STICKER_CHUNKS; ++k) _mm_store_si128(reinterpret_cast<__m128i*>(s) + k, chunk[k]);
+}
+
+// two 32-byte registers; each source chunk is copied into both lanes so
+// one shuffle fills two output chunks, eight shuffles per move
+__attribute__((target("avx2")))
+static void applyAVX2(uint8_t* s, const Move* seq, size_t count)
+{
+    __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(s));
+    __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(s + 32));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const StickerShuffle& sh = kStickerShuffles[moveIndex(seq[i])];
+        const __m256i src[STICKER_CHUNKS] = {
+            _mm256_permute2x128_si256(lo, lo, 0x00), _mm256_permute2x128_si256(lo, lo, 0x11),
+            _mm256_permute2x128_si256(hi, hi, 0x00), _mm256_permute2x128_si256(hi, hi, 0x11) };
+        __m256i outLo = _mm256_setzero_si256(), outHi = _mm256_setzero_si256();
+        for (int k = 0; k < STICKER_CHUNKS; ++k)
+        {
+            outLo = _mm256_or_si256(outLo, _mm256_shuffle_epi8(src[k], _mm256_load_si256(reinterpret_cast<const __m256i*>(sh.mask[k][0]))));
+            outHi = _mm256_or_si256(outHi, _mm256_shuffle_epi8(src[k], _mm256_load_si256(reinterpret_cast<const __m256i*>(sh.mask[k][2]))));
+        }
+        lo = outLo;
+        hi = outHi;
+    }
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s + 32), hi);
+}
+
+#endif
+
+bool stickerKernelSupported(StickerKernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar: return true;
+#if RUBIK_X86_SHUFFLE
+    case KernelSSSE3:  return __builtin_cpu_supports("ssse3");
+    case KernelAVX2:   return __builtin_cpu_supports("avx2");
+#endif
+    default:           return false;
+    }
+}
+
+const char* stickerKernelName(StickerKernel kernel)
+{
+    static const char* const kNames[KernelCount] = { "scalar", "ssse3", "avx2" };
+    return kernel >= 0 && kernel < KernelCount ? kNames[kernel] : "unknown";
+}
+
+StickerKernel activeStickerKernel()
+{
+    static const StickerKernel active = [] {
+        for (int k = KernelCount - 1; k > KernelScalar; --k)
+            if (stickerKernelSupported(StickerKernel(k))) return StickerKernel(k);
+        return KernelScalar;
+    }();
+    return active;
+}
+
+void applyStickerMoves(StickerKernel kernel, uint8_t* stickers, const Move* seq, size_t count)
+{
+    switch (kernel)
+    {
+#if RUBIK_X86_SHUFFLE
+    case KernelAVX2:  applyAVX2(stickers, seq, count); break;
+    case KernelSSSE3: applySSSE3(stickers, seq, count); break;
+#endif
+    default:          applyScalar(stickers, seq, count); break;
+    }
+}
+
+// ----- Reference Implementation -----
+
+// the face-by-face rotation code RubiksCube used before the sticker tables,
+// kept only as the reference they are checked against
+struct LegacyCube
+{
+    array<Side, Face::Count> faces_;
+
+    explicit LegacyCube(const RubiksCube& c)
+    {
+        for (int f = 0; f < Face::Count; ++f) faces_[f] = c.face(Face(f));
+    }
+
+    void applyMove(Face f, Turn t)
+    {
+        switch (f)
+        {
+        case Up:    rotateTop(t);    break;
+        case Down:  rotateBottom(t); break;
+        case Left:  rotateLeft(t);   break;
+        case Right: rotateRight(t);  break;
+        case Front: rotateFront(t);  break;
+        case Back:  rotateBack(t);   break;
+        default:    break;
+        }
+    }
+
+    void rotateTop(Turn);
+    void rotateBottom(Turn);
+    void rotateLeft(Turn);
+    void rotateRight(Turn);
+    void rotateFront(Turn);
+    void rotateBack(Turn);
+};
+
+void LegacyCube::rotateTop(Turn t)
+{
+    Side &U = faces_[Up];
+    auto cwNeighbors = [this]() {
+        Side &F = faces_[Front], &R = faces_[Right], &B = faces_[Back], &L = faces_[Left];
+        Color tmp[Side::SIZE];
+        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = F.squares[0][i];
+        for (int i = 0; i < Side::SIZE; ++i) F.squares[0][i] = R.squares[0][i];
+        for (int i = 0; i < Side::SIZE; ++i) R.squares[0][i] = B.squares[0][i];
+        for (int i = 0; i < Side::SIZE; ++i) B.squares[0][i] = L.squares[0][i];
+        for (int i = 0; i < Side::SIZE; ++i) L.squares[0][i] = tmp[i];
+    };
+    switch (t) {
+    case CW: U.rotateCW(); cwNeighbors(); break;
+    case CCW: U.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
+    case Double: U.rotate180(); cwNeighbors(); cwNeighbors(); break;
+    }
+}
+
+void LegacyCube::rotateBottom(Turn t)
+{
+    Side &D = faces_[Down];
+    auto cwNeighbors = [this]() {
+        Side &F = faces_[Front], &R = faces_[Right], &B = faces_[Back], &L = faces_[Left];
+        Color tmp[Side::SIZE];
+        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = F.squares[Side::SIZE - 1][i];
+        for (int i = 0; i < Side::SIZE; ++i) F.squares[Side::SIZE - 1][i] = L.squares[Side::SIZE - 1][i];
+        for (int i = 0; i < Side::SIZE; ++i) L.squares[Side::SIZE - 1][i] = B.squares[Side::SIZE - 1][i];
+        for (int i = 0; i < Side::SIZE; ++i) B.squares[Side::SIZE - 1][i] = R.squares[Side::SIZE - 1][i];
+        for (int i = 0; i < Side::SIZE; ++i) R.squares[Side::SIZE - 1][i] = tmp[i];
+    };
+    switch (t) {
+    case CW: D.rotateCW(); cwNeighbors(); break;
+    case CCW: D.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
+    case Double: D.rotate180(); cwNeighbors(); cwNeighbors(); break;
+    }
+}
+
+void LegacyCube::rotateLeft(Turn t)
+{
+    Side &L = faces_[Left];
+    auto cwNeighbors = [this]() {
+        Side &U = faces_[Up], &F = faces_[Front], &D = faces_[Down], &B = faces_[Back];
+        Color tmp[Side::SIZE];
+        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[i][0];
+        for (int i = 0; i < Side::SIZE; ++i) U.squares[i][0] = B.squares[Side::SIZE - 1 - i][Side::SIZE - 1];
+        for (int i = 0; i < Side::SIZE; ++i) B.squares[i][Side::SIZE - 1] = D.squares[Side::SIZE - 1 - i][0];
+        for (int i = 0; i < Side::SIZE; ++i) D.squares[i][0] = F.squares[i][0];
+        for (int i = 0; i < Side::SIZE; ++i) F.squares[i][0] = tmp[i];
+    };
+    switch (t) {
+    case CW: L.rotateCW(); cwNeighbors(); break;
+    case CCW: L.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
+    case Double: L.rotate180(); cwNeighbors(); cwNeighbors(); break;
+    }
+}
+
+void LegacyCube::rotateRight(Turn t)
+{
+    Side &R = faces_[Right];
+    auto cwNeighbors = [this]() {
+        Side &U = faces_[Up], &F = faces_[Front], &D = faces_[Down], &B = faces_[Back];
+        Color tmp[Side::SIZE];
+        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[i][Side::SIZE - 1];
+        for (int i = 0; i < Side::SIZE; ++i) U.squares[i][Side::SIZE - 1] = F.squares[i][Side::SIZE - 1];
+        for (int i = 0; i < Side::SIZE; ++i) F.squares[i][Side::SIZE - 1] = D.squares[i][Side::SIZE - 1];
+        for (int i = 0; i < Side::SIZE; ++i) D.squares[i][Side::SIZE - 1] = B.squares[Side::SIZE - 1 - i][0];
+        for (int i = 0; i < Side::SIZE; ++i) B.squares[i][0] = tmp[Side::SIZE - 1 - i];
+    };
+    switch (t) {
+    case CW: R.rotateCW(); cwNeighbors(); break;
+    case CCW: R.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
+    case Double: R.rotate180(); cwNeighbors(); cwNeighbors(); break;
+    }
+}
+
+void LegacyCube::rotateFront(Turn t)
+{
+    Side &F = faces_[Front];
+    auto cwNeighbors = [this]() {
+        Side &U = faces_[Up], &D = faces_[Down], &L = faces_[Left], &R = faces_[Right];
+        Color tmp[Side::SIZE];
+        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[Side::SIZE - 1][i];
+        for (int i = 0; i < Side::SIZE; ++i) U.squares[Side::SIZE - 1][i] = L.squares[Side::SIZE - 1 - i][Side::SIZE - 1];
+        for (int i = 0; i < Side::SIZE; ++i) L.squares[i][Side::SIZE - 1] = D.squares[0][i];
+        for (int i = 0; i < Side::SIZE; ++i) D.squares[0][i] = R.squares[Side::SIZE - 1 - i][0];
+        for (int i = 0; i < Side::SIZE; ++i) R.squares[i][0] = tmp[i];
+    };
+    switch (t) {
+    case CW: F.rotateCW(); cwNeighbors(); break;
+    case CCW: F.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
+    case Double: F.rotate180(); cwNeighbors(); cwNeighbors(); break;
+    }
+}
+
+void LegacyCube::rotateBack(Turn t)
+{
+    Side &B = faces_[Back];
+    auto cwNeighbors = [this]() {
+        Side &U = faces_[Up], &D = faces_[Down], &L = faces_[Left], &R = faces_[Right];
+        Color tmp[Side::SIZE];
+        for (int i = 0; i < Side::SIZE; ++i) tmp[i] = U.squares[0][i];
+        for (int i = 0; i < Side::SIZE; ++i) U.squares[0][i] = R.squares[i][Side::SIZE - 1];
+        for (int i = 0; i < Side::SIZE; ++i) R.squares[i][Side::SIZE - 1] = D.squares[Side::SIZE - 1][Side::SIZE - 1 - i];
+        for (int i = 0; i < Side::SIZE; ++i) D.squares[Side::SIZE - 1][i] = L.squares[i][0];
+        for (int i = 0; i < Side::SIZE; ++i) L.squares[i][0] = tmp[Side::SIZE - 1 - i];
+    };
+    switch (t) {
+    case CW: B.rotateCW(); cwNeighbors(); break;
+    case CCW: B.rotateCCW(); cwNeighbors(); cwNeighbors(); cwNeighbors(); break;
+    case Double: B.rotate180(); cwNeighbors(); cwNeighbors(); break;
+    }
+}
+// ----- Self Check -----
+
+bool stickerMoveSelfCheck(std::ostream& out)
+{
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1);
+
+    bool ok = true;
+    RubiksCube cube;
+    for (int trial = 0; trial < 64 && ok; ++trial)
+    {
+        alignas(32) array<uint8_t, STICKER_STORAGE> start{};
+        for (int i = 0; i < STICKER_COUNT; ++i) start[i] = uint8_t(cube.sticker(Face(i / 9), i / 3 % 3, i % 3));
+
+        for (int m = 0; m < MOVE_COUNT && ok; ++m)
+        {
+            const Move& mv = allMoves[m];
+            LegacyCube slow(cube);
+            slow.applyMove(mv.face, mv.turn);
+            auto expected = [&](int i) { return uint8_t(slow.faces_[i / 9].squares[i / 3 % 3][i % 3]); };
+
+            // the plain table gather
+            for (int i = 0; i < STICKER_COUNT; ++i)
+                if (start[kStickerMoves[m][i]] != expected(i)) ok = false;
+            if (!ok) { out << "sticker table for " << moveToString(mv) << " disagrees with the reference rotation\n"; break; }
+
+            // each kernel, which must also leave the padding zero
+            for (int k = 0; k < KernelCount && ok; ++k)
+            {
+                if (!stickerKernelSupported(StickerKernel(k))) continue;
+                alignas(32) array<uint8_t, STICKER_STORAGE> s = start;
+                applyStickerMoves(StickerKernel(k), s.data(), &mv, 1);
+                for (int i = 0; i < STICKER_STORAGE; ++i)
+                    if (s[i] != (i < STICKER_COUNT ? expected(i) : 0)) ok = false;
+                if (!ok) out << stickerKernelName(StickerKernel(k)) << " kernel " << moveToString(mv)
+                             << " disagrees with the reference rotation\n";
+            }
+        }
+        // walk to a new start state for the next round
+        cube.applyMove(moveDist(rng));
+    }
+
+    // a whole sequence kept in registers, then undone, must come back solved
+    vector<Move> seq, undo;
+    for (int i = 0; i < 40; ++i) seq.push_back(allMoves[moveDist(rng)]);
+    for (auto it = seq.rbegin(); it != seq.rend(); ++it) undo.push_back(inverseOf(*it));
+    RubiksCube there;
+    there.applyMoves(seq);
+    RubiksCube back = there;
+    back.applyMoves(undo);
+    if (there.isSolved() || !back.isSolved())
+    {
+        out << "move sequence and its inverse do not return to solved\n";
+        ok = false;
+    }
+
+    if (ok) out << "sticker move self-check passed (" << MOVE_COUNT << " moves, "
+                << stickerKernelName(activeStickerKernel()) << " kernel)\n";
+    return ok;
+}
@@ -0,0 +1,152 @@
+#ifndef STICKERMOVES_HPP
+#define STICKERMOVES_HPP
+
+#include "stickergeometry.hpp"
+
+///// STICKER PERMUTATIONS /////
+
+// Every move as a gather over the flat sticker array: after move m,
+// sticker i holds what sticker kStickerMoves[m][i] held before. The tables
+// are generated at compile time by turning each sticker's position on the
+// surface of the cube (stickergeometry.hpp) about the face's axis.
+
+namespace stickergeo
+{
+    // a clockwise quarter turn seen from outside the face, about its normal n
+    constexpr Vec3 quarterTurn(const Vec3& v, const Vec3& n)
+    {
+        const Vec3 c = cross(n, v);
+        const int along = dot(n, v);
+        return { n.x * along - c.x, n.y * along - c.y, n.z * along - c.z };
+    }
+
+    constexpr array<uint8_t, STICKER_COUNT> quarterTurnGather(int face)
+    {
+        const Vec3& n = kNormal[face];
+        array<uint8_t, STICKER_COUNT> gather{};
+        for (int i = 0; i < STICKER_COUNT; ++i) gather[i] = uint8_t(i);
+        for (int i = 0; i < STICKER_COUNT; ++i)
+        {
+            const Vec3 p = point(i);
+            if (dot(p, n) < 1) continue; // not in the turning layer
+            const Vec3 normal = kNormal[i / 9];
+            gather[stickerAt(quarterTurn(p, n), quarterTurn(normal, n))] = uint8_t(i);
+        }
+        return gather;
+    }
+
+    constexpr array<array<uint8_t, STICKER_COUNT>, MOVE_COUNT> makeStickerMoves()
+    {
+        array<array<uint8_t, STICKER_COUNT>, MOVE_COUNT> moves{};
+        for (int f = 0; f < Face::Count; ++f)
+        {
+            const array<uint8_t, STICKER_COUNT> q = quarterTurnGather(f);
+            // gathering through q k times is k quarter turns
+            for (int turns = 1; turns <= 3; ++turns)
+            {
+                array<uint8_t, STICKER_COUNT>& g = moves[f * 3 + (turns == 1 ? CW : turns == 2 ? Double : CCW)];
+                for (int i = 0; i < STICKER_COUNT; ++i)
+                {
+                    int src = i;
+                    for (int k = 0; k < turns; ++k) src = q[src];
+                    g[i] = uint8_t(src);
+                }
+            }
+        }
+        return moves;
+    }
+}
+
+inline constexpr array<array<uint8_t, STICKER_COUNT>, MOVE_COUNT> kStickerMoves = stickergeo::makeStickerMoves();
+
+// A quarter turn moves 20 stickers in five 4-cycles (face corners, face
+// edges and three rings round the side). Cycle k lists stickers that each
+// take the colour of the next one, so all three turns of a face rotate the
+// same lists, by one, two or three places.
+static constexpr int STICKER_CYCLES = 5;
+
+struct StickerCycles { uint8_t cycle[STICKER_CYCLES][4]; };
+
+namespace stickergeo
+{
+    constexpr array<StickerCycles, Face::Count> makeStickerCycles()
+    {
+        array<StickerCycles, Face::Count> cycles{};
+        for (int f = 0; f < Face::Count; ++f)
+        {
+            const array<uint8_t, STICKER_COUNT>& q = kStickerMoves[f * 3 + CW];
+            bool seen[STICKER_COUNT] = {};
+            int n = 0;
+            for (int i = 0; i < STICKER_COUNT; ++i)
+            {
+                if (q[i] == i || seen[i]) continue;
+                for (int k = 0, s = i; k < 4; ++k, s = q[s])
+                {
+                    cycles[f].cycle[n][k] = uint8_t(s);
+                    seen[s] = true;
+                }
+                ++n;
+            }
+        }
+        return cycles;
+    }
+}
+
+inline constexpr array<StickerCycles, Face::Count> kStickerCycles = stickergeo::makeStickerCycles();
+
+// The same gathers as byte shuffle masks for pshufb, which only picks bytes
+// within one 16-byte register. The padded state is four such chunks, so
+// output chunk o is the OR of shuffling every source chunk k through
+// mask[k][o]; a mask byte of 0x80 zeroes the output byte, so each source
+// fills only the bytes it owns and the padding stays zero. Masks for output
+// chunks 0-1 and 2-3 sit side by side for 32-byte AVX2 loads.
+static constexpr int STICKER_CHUNKS = STICKER_STORAGE / 16;
+
+struct alignas(32) StickerShuffle { uint8_t mask[STICKER_CHUNKS][STICKER_CHUNKS][16]; };
+
+namespace stickergeo
+{
+    constexpr array<StickerShuffle, MOVE_COUNT> makeStickerShuffles()
+    {
+        array<StickerShuffle, MOVE_COUNT> shuffles{};
+        for (int m = 0; m < MOVE_COUNT; ++m)
+            for (int k = 0; k < STICKER_CHUNKS; ++k)
+                for (int i = 0; i < STICKER_STORAGE; ++i)
+                {
+                    const int src = i < STICKER_COUNT ? kStickerMoves[m][i] : -1;
+                    shuffles[m].mask[k][i / 16][i % 16] = src >= 0 && src / 16 == k ? uint8_t(src % 16) : 0x80;
+                }
+        return shuffles;
+    }
+
+    constexpr array<uint8_t, STICKER_STORAGE> makeSolvedStickers()
+    {
+        // colour of each face's center, in Face order
+        const Color faceColors[Face::Count] = { White, Yellow, Orange, Red, Green, Blue };
+        array<uint8_t, STICKER_STORAGE> solved{};
+        for (int i = 0; i < STICKER_COUNT; ++i) solved[i] = uint8_t(faceColors[i / 9]);
+        return solved;
+    }
+}
+
+inline constexpr array<StickerShuffle, MOVE_COUNT> kStickerShuffles = stickergeo::makeStickerShuffles();
+
+// the only solved state: face turns never move the centers
+alignas(32) inline constexpr array<uint8_t, STICKER_STORAGE> kSolvedStickers = stickergeo::makeSolvedStickers();
+
+// ways to apply a run of moves to a padded sticker array: the cycle walk
+// anywhere, and the shuffle masks where the CPU has pshufb. RubiksCube uses
+// the widest one the CPU supports, picked on first use.
+enum StickerKernel { KernelScalar = 0, KernelSSSE3, KernelAVX2, KernelCount };
+
+bool stickerKernelSupported(StickerKernel kernel);
+const char* stickerKernelName(StickerKernel kernel);
+StickerKernel activeStickerKernel();
+void applyStickerMoves(StickerKernel kernel, uint8_t* stickers, const Move* seq, size_t count);
+
+// checks kStickerMoves and every kernel this CPU supports against the
+// original face-by-face rotation code for every move; prints failures to
+// out, true when all agree
+bool stickerMoveSelfCheck(std::ostream& out);
+
+#endif // STICKERMOVES_HPP
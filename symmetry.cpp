@@ -0,0 +1,315 @@
+#include "symmetry.hpp"
+#include "stickergeometry.hpp"
+#include <mutex>
+#include <ostream>
+
+// ----- Geometry -----
+
+using stickergeo::Vec3;
+using stickergeo::kNormal;
+
+// (M v)[i] = sign[i] * v[axis[i]]
+struct SymMatrix
+{
+    int axis[3];
+    int sign[3];
+
+    Vec3 apply(const Vec3& v) const
+    {
+        const int in[3] = { v.x, v.y, v.z };
+        return { sign[0] * in[axis[0]], sign[1] * in[axis[1]], sign[2] * in[axis[2]] };
+    }
+
+    int determinant() const
+    {
+        // parity of the axis permutation times the signs
+        int inversions = (axis[0] > axis[1]) + (axis[0] > axis[2]) + (axis[1] > axis[2]);
+        return (inversions & 1 ? -1 : 1) * sign[0] * sign[1] * sign[2];
+    }
+};
+
+static StickerPos stickerImage(const SymMatrix& m, const StickerPos& p)
+{
+    const int s = stickergeo::stickerAt(m.apply(stickergeo::point(stickerIndex(p.f, p.row, p.col))),
+                                        m.apply(kNormal[p.f]));
+    return { Face(s / 9), s % 9 / 3, s % 3 };
+}
+
+// ----- Tables -----
+
+struct SymmetryTables
+{
+    SymMatrix matrix[N_SYM];
+    uint8_t   face[N_SYM][Face::Count];
+    uint8_t   move[N_SYM][MOVE_COUNT];
+    uint8_t   inverse[N_SYM];
+
+    // slot i goes to cornerSlot[s][i]; its packed byte is rewritten by cornerByte
+    uint8_t   cornerSlot[N_SYM][CubieCube::CORNERS];
+    uint8_t   cornerByte[N_SYM][CubieCube::CORNERS][32];
+    uint8_t   edgeSlot[N_SYM][CubieCube::EDGES];
+    uint8_t   edgeByte[N_SYM][CubieCube::EDGES][32];
+};
+
+// sticker colours are kept as the home face of the sticker
+using FaceGrid = Face[Face::Count][3][3];
+
+static int findCornerSlot(const SymMatrix& m, int slot)
+{
+    StickerPos p = stickerImage(m, kCornerSlots[slot].sticker[0]);
+    for (int i = 0; i < CubieCube::CORNERS; ++i)
+        for (const StickerPos& q : kCornerSlots[i].sticker)
+            if (q.f == p.f && q.row == p.row && q.col == p.col) return i;
+    return -1;
+}
+
+static int findEdgeSlot(const SymMatrix& m, int slot)
+{
+    StickerPos p = stickerImage(m, kEdgeSlots[slot].sticker[0]);
+    for (int i = 0; i < CubieCube::EDGES; ++i)
+        for (const StickerPos& q : kEdgeSlots[i].sticker)
+            if (q.f == p.f && q.row == p.row && q.col == p.col) return i;
+    return -1;
+}
+
+static SymmetryTables buildSymmetryTables()
+{
+    SymmetryTables t{};
+
+    // identity first, then the UD-preserving ones (y stays on the y axis)
+    static const int kAxisOrders[6][3] = { {0, 1, 2}, {2, 1, 0}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1} };
+    int n = 0;
+    for (const auto& axis : kAxisOrders)
+        for (int signs = 0; signs < 8; ++signs)
+        {
+            SymMatrix& m = t.matrix[n++];
+            for (int i = 0; i < 3; ++i)
+            {
+                m.axis[i] = axis[i];
+                m.sign[i] = (signs >> i) & 1 ? -1 : 1;
+            }
+        }
+
+    for (int s = 0; s < N_SYM; ++s)
+    {
+        const SymMatrix& m = t.matrix[s];
+        for (int f = 0; f < Face::Count; ++f) t.face[s][f] = uint8_t(stickergeo::faceOf(m.apply(kNormal[f])));
+
+        // a reflection turns clockwise into anticlockwise
+        for (int mv = 0; mv < MOVE_COUNT; ++mv)
+        {
+            int turn = mv % 3;
+            if (m.determinant() < 0 && turn != Double) turn = turn == CW ? CCW : CW;
+            t.move[s][mv] = uint8_t(t.face[s][mv / 3] * 3 + turn);
+        }
+
+        // M^-1 is the transpose
+        for (int u = 0; u < N_SYM; ++u)
+        {
+            const SymMatrix& w = t.matrix[u];
+            bool inverse = true;
+            for (int i = 0; i < 3; ++i)
+                inverse = inverse && w.axis[m.axis[i]] == i && w.sign[m.axis[i]] == m.sign[i];
+            if (inverse) t.inverse[s] = uint8_t(u);
+        }
+
+        // Corners: paint piece c with twist o into slot i, carry the stickers
+        // across and recolour them, then read the piece back as the sticker
+        // conversion does.
+        for (int i = 0; i < CubieCube::CORNERS; ++i)
+        {
+            const int dst = findCornerSlot(m, i);
+            t.cornerSlot[s][i] = uint8_t(dst);
+            for (int c = 0; c < CubieCube::CORNERS; ++c)
+                for (int o = 0; o < 3; ++o)
+                {
+                    FaceGrid grid{};
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        StickerPos from = kCornerSlots[i].sticker[(k + o) % 3];
+                        StickerPos to = stickerImage(m, from);
+                        grid[to.f][to.row][to.col] = Face(t.face[s][kCornerSlots[c].sticker[k].f]);
+                    }
+                    Face cur[3];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const StickerPos& p = kCornerSlots[dst].sticker[k];
+                        cur[k] = grid[p.f][p.row][p.col];
+                    }
+                    for (int j = 0; j < CubieCube::CORNERS; ++j)
+                        for (int ori = 0; ori < 3; ++ori)
+                        {
+                            bool match = true;
+                            for (int k = 0; k < 3 && match; ++k)
+                                match = cur[(k + ori) % 3] == kCornerSlots[j].sticker[k].f;
+                            if (match) t.cornerByte[s][i][c | (o << 3)] = uint8_t(j | (ori << 3));
+                        }
+                }
+        }
+
+        for (int i = 0; i < CubieCube::EDGES; ++i)
+        {
+            const int dst = findEdgeSlot(m, i);
+            t.edgeSlot[s][i] = uint8_t(dst);
+            for (int c = 0; c < CubieCube::EDGES; ++c)
+                for (int o = 0; o < 2; ++o)
+                {
+                    FaceGrid grid{};
+                    for (int k = 0; k < 2; ++k)
+                    {
+                        StickerPos from = kEdgeSlots[i].sticker[(k + o) % 2];
+                        StickerPos to = stickerImage(m, from);
+                        grid[to.f][to.row][to.col] = Face(t.face[s][kEdgeSlots[c].sticker[k].f]);
+                    }
+                    const StickerPos& p0 = kEdgeSlots[dst].sticker[0];
+                    const StickerPos& p1 = kEdgeSlots[dst].sticker[1];
+                    Face c0 = grid[p0.f][p0.row][p0.col], c1 = grid[p1.f][p1.row][p1.col];
+                    for (int j = 0; j < CubieCube::EDGES; ++j)
+                    {
+                        Face s0 = kEdgeSlots[j].sticker[0].f, s1 = kEdgeSlots[j].sticker[1].f;
+                        if (c0 == s0 && c1 == s1) t.edgeByte[s][i][c | (o << 4)] = uint8_t(j);
+                        if (c0 == s1 && c1 == s0) t.edgeByte[s][i][c | (o << 4)] = uint8_t(j | (1 << 4));
+                    }
+                }
+        }
+    }
+    return t;
+}
+
+// only needs the constant sticker layout, so it is safe to build at static init
+static const SymmetryTables kSym = buildSymmetryTables();
+
+// ----- Conjugation -----
+
+CubieCube conjugate(const CubieCube& c, int sym)
+{
+    CubieCube out;
+    for (int i = 0; i < CubieCube::CORNERS; ++i)
+        out.corners[kSym.cornerSlot[sym][i]] = kSym.cornerByte[sym][i][c.corners[i]];
+    for (int i = 0; i < CubieCube::EDGES; ++i)
+        out.edges[kSym.edgeSlot[sym][i]] = kSym.edgeByte[sym][i][c.edges[i]];
+    return out;
+}
+
+int conjugateMove(int sym, int move) { return kSym.move[sym][move]; }
+int inverseSymmetry(int sym)         { return kSym.inverse[sym]; }
+bool isReflection(int sym)           { return kSym.matrix[sym].determinant() < 0; }
+Face symmetryFace(int sym, Face f)   { return Face(kSym.face[sym][f]); }
+
+CubieCube canonicalCube(const CubieCube& c, int symCount, int* sym)
+{
+    CubieCube best = c;
+    int bestSym = 0;
+    for (int s = 1; s < symCount; ++s)
+    {
+        CubieCube d = conjugate(c, s);
+        if (d.corners < best.corners || (d.corners == best.corners && d.edges < best.edges)) { best = d; bestSym = s; }
+    }
+    if (sym) *sym = bestSym;
+    return best;
+}
+
+// ----- FlipSlice Classes -----
+
+static vector<uint32_t> flipSliceSym; // class << 4 | sym
+static vector<uint32_t> flipSliceReps;
+
+void initFlipSliceSym()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        const uint32_t UNSET = 0xFFFFFFFFu;
+        flipSliceSym.assign(N_FLIPSLICE, UNSET);
+        flipSliceReps.reserve(N_FLIPSLICE_CLASS);
+
+        for (int idx = 0; idx < N_FLIPSLICE; ++idx)
+        {
+            if (flipSliceSym[idx] != UNSET) continue;
+
+            // the first state met in index order is its class representative
+            const uint32_t cls = uint32_t(flipSliceReps.size());
+            flipSliceReps.push_back(uint32_t(idx));
+
+            CubieCube rep;
+            setSliceCoord(rep, idx % N_SLICE);
+            setFlipCoord(rep, idx / N_SLICE);
+            for (int s = 0; s < N_UD_SYM; ++s)
+            {
+                CubieCube d = conjugate(rep, s);
+                int j = flipCoord(d) * N_SLICE + sliceCoord(d);
+                if (flipSliceSym[j] == UNSET) flipSliceSym[j] = (cls << 4) | uint32_t(inverseSymmetry(s));
+            }
+        }
+    });
+}
+
+SymCoord flipSliceSymCoord(int flip, int slice)
+{
+    uint32_t v = flipSliceSym[flip * N_SLICE + slice];
+    return { int(v >> 4), int(v & 15) };
+}
+
+SymCoord flipSliceSymCoord(const CubieCube& c)
+{
+    return flipSliceSymCoord(flipCoord(c), sliceCoord(c));
+}
+
+int flipSliceRep(int cls) { return int(flipSliceReps[cls]); }
+
+// ----- Self Check -----
+
+bool symmetrySelfCheck(std::ostream& out)
+{
+    initCoordTables();
+    initFlipSliceSym();
+
+    bool ok = true;
+    auto fail = [&](const char* what, int sym) {
+        out << "symmetry " << sym << ": " << what << "\n";
+        ok = false;
+    };
+
+    if (int(flipSliceReps.size()) != N_FLIPSLICE_CLASS) {
+        out << "flipslice: " << flipSliceReps.size() << " classes, expected " << N_FLIPSLICE_CLASS << "\n";
+        ok = false;
+    }
+
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> moveDist(0, MOVE_COUNT - 1);
+    for (int s = 0; s < N_SYM; ++s)
+    {
+        int inv = inverseSymmetry(s);
+        if (!conjugate(CubieCube(), s).isSolved()) fail("solved cube does not stay solved", s);
+
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            // conjugating a scrambled state equals scrambling by conjugated moves
+            CubieCube c, expect;
+            for (int i = 0; i < 30; ++i)
+            {
+                int m = moveDist(rng);
+                c.applyMove(m);
+                expect.applyMove(conjugateMove(s, m));
+            }
+            CubieCube got = conjugate(c, s);
+            if (got != expect)                   fail("conjugated moves disagree with conjugated state", s);
+            if (!got.isValid())                  fail("conjugate is not a legal cube", s);
+            if (conjugate(got, inv) != c)        fail("inverse symmetry does not undo it", s);
+            if (canonicalCube(got) != canonicalCube(c)) fail("canonical form differs across a class", s);
+
+            if (s < N_UD_SYM)
+            {
+                SymCoord a = flipSliceSymCoord(c), b = flipSliceSymCoord(got);
+                if (a.cls != b.cls) fail("flipslice class changes under conjugation", s);
+                CubieCube r = conjugate(c, a.sym);
+                if (flipCoord(r) * N_SLICE + sliceCoord(r) != flipSliceRep(a.cls))
+                    fail("flipslice symmetry does not reach the representative", s);
+            }
+        }
+        if (!ok) break;
+    }
+    if (ok) out << "symmetry self-check passed (" << N_SYM << " symmetries, "
+                << flipSliceReps.size() << " flipslice classes)\n";
+    return ok;
+}
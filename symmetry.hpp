@@ -0,0 +1,58 @@
+#ifndef SYMMETRY_HPP
+#define SYMMETRY_HPP
+
+#include "coords.hpp"
+#include <iosfwd>
+
+///// CUBE SYMMETRIES /////
+
+// The 48 rotations and reflections of the cube, as the signed permutation
+// matrices acting on (x = R, y = U, z = F). Index 0 is the identity and the
+// first N_UD_SYM keep the U-D axis in place (possibly turned upside down),
+// which are the ones that preserve the two-phase subgroup.
+//
+// conjugate(c, s) is the cube c seen through symmetry s: every sticker is
+// carried to its image under the matrix and recoloured by where its face
+// went. Turning a conjugated cube by conjugateMove(s, m) gives the same
+// state as conjugating after turning by m.
+
+static constexpr int N_SYM    = 48;
+static constexpr int N_UD_SYM = 16;
+
+CubieCube conjugate(const CubieCube& c, int sym);
+int  conjugateMove(int sym, int move);
+int  inverseSymmetry(int sym);
+bool isReflection(int sym);
+Face symmetryFace(int sym, Face f); // where face f is carried
+
+// smallest conjugate over the first symCount symmetries, for keying caches;
+// sym, when given, receives the symmetry that reaches it
+CubieCube canonicalCube(const CubieCube& c, int symCount = N_SYM, int* sym = nullptr);
+
+///// SYM-REDUCED FLIPSLICE /////
+
+// flip x slice (1,013,760 states) folded by the 16 UD symmetries into
+// N_FLIPSLICE_CLASS classes. A state's entry gives its class and the
+// symmetry that carries the state onto the class representative.
+
+static constexpr int N_FLIPSLICE       = N_FLIP * N_SLICE;
+static constexpr int N_FLIPSLICE_CLASS = 64430;
+
+struct SymCoord
+{
+    int cls; // class index, 0 <= cls < N_FLIPSLICE_CLASS
+    int sym; // conjugate(state, sym) is the representative
+};
+
+// builds the class table once (about 4 MB); later calls return immediately
+void initFlipSliceSym();
+
+SymCoord flipSliceSymCoord(int flip, int slice);
+SymCoord flipSliceSymCoord(const CubieCube& c);
+int flipSliceRep(int cls); // flip * N_SLICE + slice of the representative
+
+// checks conjugated sequences against conjugated states and the class table
+// against random cubes; prints failures to out, true when everything holds
+bool symmetrySelfCheck(std::ostream& out);
+
+#endif // SYMMETRY_HPP
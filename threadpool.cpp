@@ -0,0 +1,108 @@
+#include "threadpool.hpp"
+
+WorkStealingPool::WorkStealingPool(int threads)
+{
+    if (threads < 1) threads = 1;
+    for (int i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+    for (int i = 1; i < threads; ++i) threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_) t.join();
+}
+
+void WorkStealingPool::run(int count, const std::function<void(int)>& task)
+{
+    if (count <= 0) return;
+
+    // publish the task before any index becomes visible to a worker
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        task_ = &task;
+        remaining_ = count;
+    }
+
+    // contiguous blocks keep each worker on neighbouring subtrees
+    const int workers = threadCount();
+    for (int w = 0; w < workers; ++w)
+    {
+        std::lock_guard<std::mutex> guard(queues_[w]->lock);
+        int begin = int((long long)count * w / workers);
+        int end   = int((long long)count * (w + 1) / workers);
+        for (int i = begin; i < end; ++i) queues_[w]->tasks.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> guard(lock_);
+    finished_.wait(guard, [this] { return remaining_ == 0; });
+    task_ = nullptr;
+}
+
+void WorkStealingPool::workerLoop(int id)
+{
+    unsigned long long seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock_);
+            wake_.wait(guard, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        drain(id);
+    }
+}
+
+// runs tasks until no queue has any left
+void WorkStealingPool::drain(int id)
+{
+    int task;
+    while (nextTask(id, task))
+    {
+        (*task_)(task);
+
+        std::lock_guard<std::mutex> guard(lock_);
+        if (--remaining_ == 0) finished_.notify_all();
+    }
+}
+
+bool WorkStealingPool::nextTask(int id, int& task)
+{
+    {
+        Queue& own = *queues_[id];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    const int workers = threadCount();
+    for (int k = 1; k < workers; ++k)
+    {
+        Queue& victim = *queues_[(id + k) % workers];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
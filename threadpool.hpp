@@ -0,0 +1,55 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///// WORK-STEALING POOL /////
+
+// Runs batches of indexed tasks. Each worker owns a deque seeded with a
+// contiguous block of task indices and takes from its front, so low indices
+// run first; an idle worker steals from the back of another worker's deque.
+// The calling thread works as worker 0.
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int threads);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int threadCount() const { return int(queues_.size()); }
+
+    // calls task(i) for every i in [0, count), returns when all have finished
+    void run(int count, const std::function<void(int)>& task);
+
+private:
+    struct Queue
+    {
+        std::mutex      lock;
+        std::deque<int> tasks;
+    };
+
+    void workerLoop(int id);
+    void drain(int id);
+    bool nextTask(int id, int& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            threads_;
+
+    std::mutex              lock_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    const std::function<void(int)>* task_ = nullptr;
+    unsigned long long      generation_ = 0;
+    int                     remaining_ = 0;
+    bool                    stop_ = false;
+};
+
+#endif // THREADPOOL_HPP
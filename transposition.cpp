@@ -0,0 +1,53 @@
+#include "transposition.hpp"
+
+TranspositionTable::TranspositionTable(size_t bytes)
+{
+    // largest power of two that fits the budget, at least one slot
+    entries_ = 1;
+    while (entries_ * 2 * sizeof(uint64_t) <= bytes) entries_ *= 2;
+    mask_ = entries_ - 1;
+    slots_.reset(new std::atomic<uint64_t>[entries_]);
+    for (size_t i = 0; i < entries_; ++i) slots_[i].store(0, std::memory_order_relaxed);
+}
+
+void TranspositionTable::newIteration()
+{
+    // stamp 0 marks an empty slot; on wrap-around old stamps would alias
+    if (++stamp_ == (1u << STAMP_BITS))
+    {
+        for (size_t i = 0; i < entries_; ++i) slots_[i].store(0, std::memory_order_relaxed);
+        stamp_ = 1;
+    }
+}
+
+TranspositionTable::Probe TranspositionTable::visit(uint64_t key, int g)
+{
+    std::atomic<uint64_t>& slot = slots_[key & mask_];
+    const uint64_t tag = key >> TAG_SHIFT;
+    const uint64_t word = (tag << TAG_SHIFT) | (stamp_ << G_BITS) | uint64_t(g);
+
+    uint64_t cur = slot.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const bool live = ((cur >> G_BITS) & ((1u << STAMP_BITS) - 1)) == stamp_;
+        const int  curG = int(cur & ((1u << G_BITS) - 1));
+
+        if (live && (cur >> TAG_SHIFT) == tag)
+        {
+            if (curG <= g) return Duplicate;
+            if (slot.compare_exchange_weak(cur, word, std::memory_order_relaxed)) return Miss;
+            continue;
+        }
+
+        // another live state keeps the slot while it is the shallower one
+        if (live && curG < g) return Miss;
+        if (slot.compare_exchange_weak(cur, word, std::memory_order_relaxed)) return live ? Replaced : Miss;
+    }
+}
+
+void TranspositionTable::addCounts(long long hits, long long misses, long long replaces)
+{
+    hits_.fetch_add(hits, std::memory_order_relaxed);
+    misses_.fetch_add(misses, std::memory_order_relaxed);
+    replaces_.fetch_add(replaces, std::memory_order_relaxed);
+}
@@ -0,0 +1,67 @@
+#ifndef TRANSPOSITION_HPP
+#define TRANSPOSITION_HPP
+
+#include "coords.hpp"
+#include <atomic>
+#include <memory>
+
+///// TRANSPOSITION TABLE /////
+
+// Fixed-size, lock-free table of states seen in the current IDA* threshold
+// pass. Each slot is one 64-bit word holding the upper hash bits, a pass
+// stamp and the smallest g the state was reached at; slots from an earlier
+// pass count as empty, so nothing has to be cleared between passes. A node
+// reached again at an equal or larger g was already searched with at least
+// as much budget and can be dropped.
+class TranspositionTable
+{
+public:
+    enum Probe { Miss, Duplicate, Replaced };
+
+    explicit TranspositionTable(size_t bytes);
+
+    size_t bytes() const { return entries_ * sizeof(uint64_t); }
+
+    // start a new threshold pass; not safe while a search is probing
+    void newIteration();
+
+    // records (key, g); Duplicate means the node can be pruned
+    Probe visit(uint64_t key, int g);
+
+    long long hits() const     { return hits_.load(std::memory_order_relaxed); }
+    long long misses() const   { return misses_.load(std::memory_order_relaxed); }
+    long long replaces() const { return replaces_.load(std::memory_order_relaxed); }
+
+    // searches count probes locally and add them once per pass or task
+    void addCounts(long long hits, long long misses, long long replaces);
+
+private:
+    static constexpr int G_BITS     = 6;
+    static constexpr int STAMP_BITS = 16;
+    static constexpr int TAG_SHIFT  = G_BITS + STAMP_BITS;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+    size_t   entries_ = 0;
+    size_t   mask_ = 0;
+    uint64_t stamp_ = 0;
+
+    std::atomic<long long> hits_{0}, misses_{0}, replaces_{0};
+};
+
+// 64-bit hash of the coordinate state and the face turned to reach it. The
+// face matters: canonical move ordering lets the successors depend on it, so
+// only a visit with the same last face has searched the same subtree.
+inline uint64_t stateKey(const CoordCube& c, int lastFace)
+{
+    auto mix = [](uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    };
+    uint64_t lo = uint64_t(c.twist) | uint64_t(c.flip) << 12 | uint64_t(c.cornerPerm) << 23 |
+                  uint64_t(c.edgeGroup[0]) << 39;
+    uint64_t hi = uint64_t(c.edgeGroup[1]) | uint64_t(c.edgeGroup[2]) << 14 | uint64_t(lastFace) << 28;
+    return mix(lo ^ mix(hi + 0x9E3779B97F4A7C15ull));
+}
+
+#endif // TRANSPOSITION_HPP
@@ -0,0 +1,274 @@
+#include "solver.hpp"
+#include "coords.hpp"
+#include <chrono>
+#include <mutex>
+
+// ----- Phase Tables -----
+
+// phase 2 only turns U and D freely and the side faces by half turns
+static constexpr int PHASE2_MOVES = 10;
+static const int kPhase2Moves[PHASE2_MOVES] = { 0, 1, 2, 3, 4, 5, 8, 11, 14, 17 };
+// longest phase 2 tried before any solution exists
+static constexpr int PHASE2_FIRST_CAP = 12;
+
+static constexpr int N_UD_EDGE_PERM = 40320; // order of the 8 U/D edges inside G1
+static constexpr int N_SLICE_PERM   = 24;    // order of the 4 slice edges inside G1
+
+static uint16_t udEdgePermMove[N_UD_EDGE_PERM][PHASE2_MOVES];
+
+// distance lower bounds, one byte per entry
+static vector<uint8_t> twistSlicePrune;  // phase 1: twist x slice
+static vector<uint8_t> flipSlicePrune;   // phase 1: flip x slice
+static vector<uint8_t> cornerSlicePrune; // phase 2: corner perm x slice perm
+static vector<uint8_t> edgeSlicePrune;   // phase 2: U/D edge perm x slice perm
+
+static int udEdgePermCoord(const CubieCube& c)
+{
+    int rank = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        int smaller = 0;
+        for (int j = i + 1; j < 8; ++j) if (c.edgePerm(j) < c.edgePerm(i)) ++smaller;
+        rank = rank * (8 - i) + smaller;
+    }
+    return rank;
+}
+
+static void setUdEdgePermCoord(CubieCube& c, int rank)
+{
+    int digits[8];
+    for (int i = 7; i >= 0; --i) { digits[i] = rank % (8 - i); rank /= (8 - i); }
+    bool used[8] = {};
+    for (int i = 0; i < 8; ++i)
+    {
+        int k = digits[i];
+        for (int v = 0; v < 8; ++v)
+        {
+            if (used[v]) continue;
+            if (k-- == 0) { c.setEdge(i, v, 0); used[v] = true; break; }
+        }
+    }
+}
+
+// plain breadth-first fill of a byte table from index 0
+template <typename Next>
+static void bfsPrune(vector<uint8_t>& table, int entries, int moves, Next next)
+{
+    table.assign(entries, 0xFF);
+    table[0] = 0;
+    int filled = 1;
+    for (int depth = 0; filled < entries; ++depth)
+    {
+        int found = 0;
+        for (int idx = 0; idx < entries; ++idx)
+        {
+            if (table[idx] != depth) continue;
+            for (int i = 0; i < moves; ++i)
+            {
+                int n = next(idx, i);
+                if (table[n] == 0xFF) { table[n] = uint8_t(depth + 1); ++found; }
+            }
+        }
+        if (found == 0) break;
+        filled += found;
+    }
+}
+
+void initTwoPhaseTables()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        initCoordTables();
+        auto t0 = std::chrono::steady_clock::now();
+
+        for (int p = 0; p < N_UD_EDGE_PERM; ++p)
+        {
+            CubieCube c;
+            setUdEdgePermCoord(c, p);
+            for (int i = 0; i < PHASE2_MOVES; ++i)
+            {
+                CubieCube moved = c;
+                moved.applyMove(kPhase2Moves[i]);
+                udEdgePermMove[p][i] = uint16_t(udEdgePermCoord(moved));
+            }
+        }
+
+        bfsPrune(twistSlicePrune, N_TWIST * N_SLICE, MOVE_COUNT, [](int idx, int m) {
+            return twistMove[idx / N_SLICE][m] * N_SLICE + sliceMove[idx % N_SLICE][m];
+        });
+        bfsPrune(flipSlicePrune, N_FLIP * N_SLICE, MOVE_COUNT, [](int idx, int m) {
+            return flipMove[idx / N_SLICE][m] * N_SLICE + sliceMove[idx % N_SLICE][m];
+        });
+        // inside G1 the slice group coordinate is just the slice edges' order
+        bfsPrune(cornerSlicePrune, N_CORNER_PERM * N_SLICE_PERM, PHASE2_MOVES, [](int idx, int i) {
+            int m = kPhase2Moves[i];
+            return cornerPermMove[idx / N_SLICE_PERM][m] * N_SLICE_PERM + edgeGroupMove[2][idx % N_SLICE_PERM][m];
+        });
+        bfsPrune(edgeSlicePrune, N_UD_EDGE_PERM * N_SLICE_PERM, PHASE2_MOVES, [](int idx, int i) {
+            int m = kPhase2Moves[i];
+            return udEdgePermMove[idx / N_SLICE_PERM][i] * N_SLICE_PERM + edgeGroupMove[2][idx % N_SLICE_PERM][m];
+        });
+
+        auto t1 = std::chrono::steady_clock::now();
+        std::clog << "Two-phase tables built in "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+    });
+}
+
+// ----- Search -----
+
+// same face twice, or opposite faces in descending order, repeat work
+static bool skipAfter(int face, int lastFace)
+{
+    if (lastFace < 0) return false;
+    return face == lastFace || (face == (lastFace ^ 1) && face < lastFace);
+}
+
+struct TwoPhaseSearch
+{
+    using Clock = std::chrono::steady_clock;
+
+    CubieCube start;
+    int path[64];
+    int bestLength;
+    vector<Move> best;
+    int targetLength;
+    Clock::time_point deadline;
+    bool timeUp = false;
+    long long nodes = 0;
+    const std::function<void(const vector<Move>&)>* onImproved = nullptr;
+    SearchProgress* progress = nullptr;
+
+    // a cancelled search ends the same way as one out of time; the budget
+    // only runs once there is a solution to return
+    bool outOfTime()
+    {
+        if ((++nodes & 1023) == 0)
+        {
+            if (!best.empty() && Clock::now() > deadline) timeUp = true;
+            if (progress)
+            {
+                progress->nodes.fetch_add(1024, std::memory_order_relaxed);
+                if (progress->cancel.load(std::memory_order_relaxed)) timeUp = true;
+            }
+        }
+        return timeUp;
+    }
+
+    bool done() const { return timeUp || (!best.empty() && bestLength <= targetLength); }
+
+    bool phase2(int cp, int ep, int sp, int depth, int togo, int lastFace)
+    {
+        if (togo == 0) return cp == 0 && ep == 0 && sp == 0;
+        if (outOfTime()) return false;
+
+        int h = std::max(cornerSlicePrune[cp * N_SLICE_PERM + sp], edgeSlicePrune[ep * N_SLICE_PERM + sp]);
+        if (h > togo) return false;
+
+        for (int i = 0; i < PHASE2_MOVES; ++i)
+        {
+            int m = kPhase2Moves[i];
+            if (skipAfter(m / 3, lastFace)) continue;
+            path[depth] = m;
+            if (phase2(cornerPermMove[cp][m], udEdgePermMove[ep][i], edgeGroupMove[2][sp][m],
+                       depth + 1, togo - 1, m / 3))
+                return true;
+        }
+        return false;
+    }
+
+    // phase 1 reached G1 with depth moves in path; finish it shorter than best
+    void startPhase2(int depth)
+    {
+        CubieCube c = start;
+        for (int i = 0; i < depth; ++i) c.applyMove(path[i]);
+
+        int cp = cornerPermCoord(c);
+        int ep = udEdgePermCoord(c);
+        int sp = edgeGroupCoord(c, 2);
+
+        // Until there is a first answer a phase 2 is held to PHASE2_FIRST_CAP
+        // moves: most G1 endpoints finish within it, and an endpoint that
+        // needs more could otherwise spend the whole budget before anything
+        // is found. Another phase 1 endpoint comes along soon enough.
+        int maxPhase2 = bestLength - depth - 1;
+        if (best.empty()) maxPhase2 = std::min(maxPhase2, PHASE2_FIRST_CAP);
+        // Phase 1 ends on a side quarter turn, so phase 2 may open with the
+        // half turn of that face: the two merge into the opposite quarter
+        // turn (R then R2 is R'). Without it a cube one such turn from G1,
+        // R for one, would only be finished the long way round.
+        for (int len = 0; len <= maxPhase2 && !timeUp; ++len)
+        {
+            if (!phase2(cp, ep, sp, depth, len, -1)) continue;
+
+            const bool merged = depth > 0 && len > 0 && path[depth] / 3 == path[depth - 1] / 3;
+            bestLength = depth + len - (merged ? 1 : 0);
+            best.clear();
+            for (int i = 0; i < depth + len; ++i) best.push_back(allMoves[path[i]]);
+            if (merged)
+            {
+                best[depth - 1] = inverseOf(best[depth - 1]);
+                best.erase(best.begin() + depth);
+            }
+            if (onImproved && *onImproved) (*onImproved)(best);
+            if (progress) progress->offerPartial(best, 0);
+            return;
+        }
+    }
+
+    void phase1(int twist, int flip, int slice, int depth, int togo, int lastFace)
+    {
+        if (done() || outOfTime()) return;
+
+        if (togo == 0)
+        {
+            // a G1 move ending phase 1 means a shorter phase 1 was already tried
+            if (twist == 0 && flip == 0 && slice == 0)
+            {
+                int last = depth > 0 ? path[depth - 1] : -1;
+                bool endsInG1Move = last >= 0 && (last / 3 < 2 || last % 3 == Double);
+                if (!endsInG1Move) startPhase2(depth);
+            }
+            return;
+        }
+
+        int h = std::max(twistSlicePrune[twist * N_SLICE + slice], flipSlicePrune[flip * N_SLICE + slice]);
+        if (h > togo) return;
+
+        for (int m = 0; m < MOVE_COUNT; ++m)
+        {
+            if (skipAfter(m / 3, lastFace)) continue;
+            path[depth] = m;
+            phase1(twistMove[twist][m], flipMove[flip][m], sliceMove[slice][m], depth + 1, togo - 1, m / 3);
+            if (done()) return;
+        }
+    }
+};
+
+vector<Move> TwoPhaseSolver::solve(const RubiksCube& cube)
+{
+    if (cube.isSolved()) return {};
+    initTwoPhaseTables();
+
+    TwoPhaseSearch s;
+    s.start = CubieCube(cube);
+    s.bestLength = maxLength_ + 1;
+    s.targetLength = targetLength_;
+    s.deadline = TwoPhaseSearch::Clock::now() +
+                 std::chrono::microseconds(static_cast<long long>(timeBudgetMs_ * 1000.0));
+    s.onImproved = &onImproved_;
+    s.progress = progress_;
+
+    int twist = twistCoord(s.start), flip = flipCoord(s.start), slice = sliceCoord(s.start);
+
+    // every phase 1 length that can still beat the best total
+    for (int depth1 = 0; depth1 < s.bestLength && !s.done(); ++depth1)
+    {
+        // the phase 1 length stands in for an IDA* threshold
+        if (s.progress) s.progress->threshold.store(depth1, std::memory_order_relaxed);
+        s.phase1(twist, flip, slice, 0, depth1, -1);
+    }
+
+    return s.best;
+}
@@ -1,11 +1,7 @@
-#include "cube.hpp"
+#include "visuals.hpp"
 #include <GL/freeglut.h>
 #include <string>
-
-// ----- Constants -----
-const float CUBE_HALF     = 1.0f;
-const float CUBIE_SPACING = (2.0f * CUBE_HALF) / 3.0f;
-const float CUBIE_SIZE    = CUBIE_SPACING * 0.92f;
+#include <cstddef>
 
 // ----- Helpers -----
 
@@ -40,162 +36,149 @@ void drawFilledRect2D(int x0,int y0,int x1,int y1)
     glEnd();
 }
 
-// used for animation
-static void axisForFace(Face f, float &ax, float &ay, float &az)
-{
-    ax = ay = az = 0.0f;
-    switch (f)
-    {
-    case Up:    ay = 1.0f; break;
-    case Down:  ay = -1.0f; break;
-    case Left:  ax = -1.0f; break;
-    case Right: ax = 1.0f;  break;
-    case Front: az = 1.0f;  break;
-    case Back:  az = -1.0f; break;
-    default: break;
-    }
-}
-
-// used for animation
-static bool cubieOnFaceLayer(int ix,int iy,int iz, Face f)
+// ----- Retained Renderer -----
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER         0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW          0x88E4
+#define GL_DYNAMIC_DRAW         0x88E8
+#endif
+
+// GL 1.5 buffer entry points, looked up at run time: opengl32 on Windows
+// only exports 1.1, and no loader library is part of the build
+typedef void (APIENTRY *GenBuffersProc)(GLsizei, GLuint*);
+typedef void (APIENTRY *BindBufferProc)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataProc)(GLenum, std::ptrdiff_t, const void*, GLenum);
+typedef void (APIENTRY *BufferSubDataProc)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*);
+
+static GenBuffersProc    glGenBuffersFn    = nullptr;
+static BindBufferProc    glBindBufferFn    = nullptr;
+static BufferDataProc    glBufferDataFn    = nullptr;
+static BufferSubDataProc glBufferSubDataFn = nullptr;
+
+static bool loadBufferProcs()
 {
-    switch(f){
-    case Front: return (iz ==  1);
-    case Back:  return (iz == -1);
-    case Right: return (ix ==  1);
-    case Left:  return (ix == -1);
-    case Up:    return (iy ==  1);
-    case Down:  return (iy == -1);
-    default:    return false;
-    }
+    glGenBuffersFn    = reinterpret_cast<GenBuffersProc>(glutGetProcAddress("glGenBuffers"));
+    glBindBufferFn    = reinterpret_cast<BindBufferProc>(glutGetProcAddress("glBindBuffer"));
+    glBufferDataFn    = reinterpret_cast<BufferDataProc>(glutGetProcAddress("glBufferData"));
+    glBufferSubDataFn = reinterpret_cast<BufferSubDataProc>(glutGetProcAddress("glBufferSubData"));
+    return glGenBuffersFn && glBindBufferFn && glBufferDataFn && glBufferSubDataFn;
 }
 
-// animation angle calculations, takes face and axis of rotation and returns rotation of face * progress
-static bool calculateAnimAngle(bool active, const Move& move, float progress, float duration, float &outAngle)
+void CubeRenderer::build()
 {
-    if (!active) return false;
+    const CubeMesh& mesh = cubeMesh();
+    vertexCount_ = mesh.vertexCount;
+    stickerBase_ = mesh.stickerBase;
 
-    float tmp = progress / duration;
-    if (tmp > 1.0f) tmp = 1.0f;
-    const float baseAngle = 90.0f;
+    // bodies stay black, stickers are filled in by updateColors
+    colors_.assign(size_t(vertexCount_) * 4, 0);
+    for (size_t v = 0; v < size_t(vertexCount_); ++v) colors_[v * 4 + 3] = 255;
 
-    // Standard CW logic
-    float faceSign = -1.0f; 
+    // per face: the turning layer's vertices, then everything else
+    indices_.clear();
+    for (int f = 0; f < Face::Count; ++f)
+    {
+        layerCount_[f] = 0;
+        for (int v = 0; v < vertexCount_; ++v)
+            if (mesh.layers[v] & (1u << f)) { indices_.push_back(GLushort(v)); ++layerCount_[f]; }
+        for (int v = 0; v < vertexCount_; ++v)
+            if (!(mesh.layers[v] & (1u << f))) indices_.push_back(GLushort(v));
+    }
 
-    switch (move.turn)
+    useBuffers_ = loadBufferProcs();
+    if (useBuffers_)
     {
-    case CW: outAngle = faceSign * baseAngle * tmp; break;
-    case CCW: outAngle = -faceSign * baseAngle * tmp; break;
-    case Double: outAngle = 2.0f * faceSign * baseAngle * tmp; break;
+        glGenBuffersFn(3, buffers_);
+        glBindBufferFn(GL_ARRAY_BUFFER, buffers_[0]);
+        glBufferDataFn(GL_ARRAY_BUFFER, std::ptrdiff_t(mesh.positions.size() * sizeof(float)), mesh.positions.data(), GL_STATIC_DRAW);
+        glBindBufferFn(GL_ARRAY_BUFFER, buffers_[1]);
+        glBufferDataFn(GL_ARRAY_BUFFER, std::ptrdiff_t(colors_.size()), colors_.data(), GL_DYNAMIC_DRAW);
+        glBindBufferFn(GL_ARRAY_BUFFER, 0);
+        glBindBufferFn(GL_ELEMENT_ARRAY_BUFFER, buffers_[2]);
+        glBufferDataFn(GL_ELEMENT_ARRAY_BUFFER, std::ptrdiff_t(indices_.size() * sizeof(GLushort)), indices_.data(), GL_STATIC_DRAW);
+        glBindBufferFn(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
-    return true;
+    built_ = true;
 }
 
-// helper function for drawing stickers on cubies
-static Color getStickerColor(const RubiksCube& cube, int ix, int iy, int iz, Face f)
+void CubeRenderer::updateColors(const RubiksCube& cube)
 {
-    const Side &side = cube.face(f);
-    int row=0,col=0;
-    switch(f){
-    case Front: row = 1-iy; col = ix+1; break;
-    case Back: row = 1-iy; col = 1-ix; break;
-    case Right: row = 1-iy; col = 1-iz; break;
-    case Left: row = 1-iy; col = iz+1; break;
-    case Up: row = iz+1; col = ix+1; break;
-    case Down: row = 1-iz; col = ix+1; break;
-    default:    break;
+    if (hasShown_ && cube == shown_) return;
+    for (int i = 0; i < STICKER_COUNT; ++i)
+    {
+        uint8_t rgba[4];
+        stickerRGBA(cube.sticker(Face(i / 9), (i % 9) / 3, i % 3), rgba);
+        for (int k = 0; k < 4; ++k)
+            std::copy(rgba, rgba + 4, &colors_[size_t(stickerBase_ + i * 4 + k) * 4]);
+    }
+    if (useBuffers_)
+    {
+        glBindBufferFn(GL_ARRAY_BUFFER, buffers_[1]);
+        glBufferSubDataFn(GL_ARRAY_BUFFER, std::ptrdiff_t(stickerBase_) * 4, STICKER_COUNT * 4 * 4,
+                          &colors_[size_t(stickerBase_) * 4]);
+        glBindBufferFn(GL_ARRAY_BUFFER, 0);
     }
-    if (row < 0) row = 0; else if (row > 2) row = 2;
-    if (col < 0) col = 0; else if (col > 2) col = 2;
-    return side.squares[row][col];
+    shown_ = cube;
+    hasShown_ = true;
+    ++colorUploads_;
 }
 
-// helper for each cubie, draws stickers on each aswell
-static void drawCubie(const RubiksCube& cube, int ix, int iy, int iz)
+void CubeRenderer::draw(const RubiksCube& cube, bool isAnimating, const Move& animMove, float animProgress, float animDuration)
 {
-    float half = CUBIE_SIZE*0.5f;
-    const float stickerInset = 0.01f;
-
-    glColor3f(0,0,0);
-    glutSolidCube(CUBIE_SIZE);
-
-    if (iz == 1) {
-        setColor(getStickerColor(cube, ix,iy,iz,Front));
-        glBegin(GL_QUADS);
-         glVertex3f(-half,-half, half+stickerInset);
-         glVertex3f( half,-half, half+stickerInset);
-         glVertex3f( half, half, half+stickerInset);
-         glVertex3f(-half, half, half+stickerInset);
-        glEnd();
-    }
-    if (iz == -1) {
-        setColor(getStickerColor(cube, ix,iy,iz,Back));
-        glBegin(GL_QUADS);
-         glVertex3f( half,-half,-half-stickerInset);
-         glVertex3f(-half,-half,-half-stickerInset);
-         glVertex3f(-half, half,-half-stickerInset);
-         glVertex3f( half, half,-half-stickerInset);
-        glEnd();
+    if (!built_) build();
+    updateColors(cube);
+
+    glEnable(GL_DEPTH_TEST);
+    float angle = 0.0f;
+    bool hasAngle = calculateAnimAngle(isAnimating, animMove, animProgress, animDuration, angle);
+
+    // with buffers bound the pointers are offsets into them
+    const char* indexBase = nullptr;
+    if (useBuffers_)
+    {
+        glBindBufferFn(GL_ARRAY_BUFFER, buffers_[0]);
+        glVertexPointer(3, GL_FLOAT, 0, nullptr);
+        glBindBufferFn(GL_ARRAY_BUFFER, buffers_[1]);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+        glBindBufferFn(GL_ELEMENT_ARRAY_BUFFER, buffers_[2]);
     }
-    if (ix == 1) {
-        setColor(getStickerColor(cube, ix,iy,iz,Right));
-        glBegin(GL_QUADS);
-         glVertex3f( half+stickerInset,-half,-half);
-         glVertex3f( half+stickerInset,-half, half);
-         glVertex3f( half+stickerInset, half, half);
-         glVertex3f( half+stickerInset, half,-half);
-        glEnd();
+    else
+    {
+        glVertexPointer(3, GL_FLOAT, 0, cubeMesh().positions.data());
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors_.data());
+        indexBase = reinterpret_cast<const char*>(indices_.data());
     }
-    if (ix == -1) {
-        setColor(getStickerColor(cube, ix,iy,iz,Left));
-        glBegin(GL_QUADS);
-         glVertex3f(-half-stickerInset,-half, half);
-         glVertex3f(-half-stickerInset,-half,-half);
-         glVertex3f(-half-stickerInset, half,-half);
-         glVertex3f(-half-stickerInset, half, half);
-        glEnd();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    if (!hasAngle)
+    {
+        glDrawArrays(GL_QUADS, 0, vertexCount_);
     }
-    if (iy == 1) {
-        setColor(getStickerColor(cube, ix,iy,iz,Up));
-        glBegin(GL_QUADS);
-         glVertex3f(-half, half+stickerInset, half);
-         glVertex3f( half, half+stickerInset, half);
-         glVertex3f( half, half+stickerInset,-half);
-         glVertex3f(-half, half+stickerInset,-half);
-        glEnd();
+    else
+    {
+        float ax=0, ay=0, az=0;
+        axisForFace(animMove.face, ax, ay, az);
+        const GLsizei layer = layerCount_[animMove.face];
+        const char* block = indexBase + size_t(animMove.face) * vertexCount_ * sizeof(GLushort);
+
+        glDrawElements(GL_QUADS, vertexCount_ - layer, GL_UNSIGNED_SHORT, block + layer * sizeof(GLushort));
+        glPushMatrix();
+        glRotatef(angle, ax, ay, az);
+        glDrawElements(GL_QUADS, layer, GL_UNSIGNED_SHORT, block);
+        glPopMatrix();
     }
-    if (iy == -1) {
-        setColor(getStickerColor(cube, ix,iy,iz,Down));
-        glBegin(GL_QUADS);
-         glVertex3f(-half,-half-stickerInset,-half);
-         glVertex3f( half,-half-stickerInset,-half);
-         glVertex3f( half,-half-stickerInset, half);
-         glVertex3f(-half,-half-stickerInset, half);
-        glEnd();
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (useBuffers_)
+    {
+        glBindBufferFn(GL_ARRAY_BUFFER, 0);
+        glBindBufferFn(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 }
-
-// Main 3D Draw Function
-void drawCube3D(const RubiksCube& cube, bool isAnimating, const Move& animMove, float animProgress, float animDuration)
-{
-    glEnable(GL_DEPTH_TEST);
-    float angle = 0.0f;
-    bool hasAngle = calculateAnimAngle(isAnimating, animMove, animProgress, animDuration, angle);
-    
-    float ax=0, ay=0, az=0;
-    if (hasAngle) axisForFace(animMove.face, ax, ay, az);
-
-    for(int ix=-1; ix<=1; ++ix)
-        for(int iy=-1; iy<=1; ++iy)
-            for(int iz=-1; iz<=1; ++iz)
-            {
-                glPushMatrix();
-                // If this cubie is on the face currently rotating, apply rotation
-                if(hasAngle && cubieOnFaceLayer(ix, iy, iz, animMove.face))
-                    glRotatef(angle, ax, ay, az);
-                    
-                glTranslatef(ix * CUBIE_SPACING, iy * CUBIE_SPACING, iz * CUBIE_SPACING);
-                drawCubie(cube, ix, iy, iz);
-                glPopMatrix();
-            }
-}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef VISUALS_HPP
+#define VISUALS_HPP
+
+#include "cubegeometry.hpp"
+#include <GL/freeglut.h>
+
+///// Visual Functions /////
+
+void setColor(Color c);
+void drawText2D(int x, int y, const std::string &s);
+void drawFilledRect2D(int x0,int y0,int x1,int y1);
+
+///// Cube Renderer /////
+
+// Draws the cube from geometry built once: the cubie bodies and the 54
+// sticker quads sit in vertex buffers (client arrays where GL 1.5 is
+// missing), and the sticker colours are rewritten only when the cube drawn
+// differs from the last one. A turning layer is one rotation around one
+// draw call, so a frame is about a dozen GL calls whatever the state.
+// Needs a current GL context; the buffers live as long as the program.
+class CubeRenderer
+{
+public:
+    void draw(const RubiksCube& cube, bool isAnimating, const Move& animMove, float animProgress, float animDuration);
+
+    bool usesBuffers() const { return useBuffers_; }
+    long long colorUploads() const { return colorUploads_; }
+
+private:
+    void build();
+    void updateColors(const RubiksCube& cube);
+
+    bool built_ = false;
+    bool useBuffers_ = false;
+    GLuint buffers_[3] = {}; // positions, colours, layer indices
+
+    vector<uint8_t>  colors_;   // rgba per cubeMesh() vertex
+    vector<GLushort> indices_;  // per face: that layer's vertices, then the rest
+    int vertexCount_ = 0;
+    int stickerBase_ = 0;       // first sticker vertex, 4 per sticker in sticker order
+    int layerCount_[Face::Count] = {};
+
+    RubiksCube shown_;
+    bool hasShown_ = false;
+    long long colorUploads_ = 0;
+};
+
+#endif // VISUALS_HPP